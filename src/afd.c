@@ -5,34 +5,43 @@
 #include <string.h>
 #include <math.h>
 
+#include "util/stack.h"
 #include "util/misc.h"
 
 /**
- * Initialise et renvoie un nouvel AFD à partir de sa définition sans effectuer de copie.
- *
- * Paramètres:
- * - Q        : le plus grand état
- * - q0       : l'état initial
- * - F        : un tableau des états finaux
- * - lenF     : le nombre d'états finaux
- * - Sigma    : une chaîne de caractères terminée par '\0' qui représentera l'alphabet
- * - lenSigma : le nombre de symboles dans l'alphabet
- *
- * Remarques:
- * - La fonction de transition de l'automate est allouée mais indéfinie dans le nouvel AFD.
- * - Le comportement si un état final est présent deux fois dans `listFinals` est indéfini.
- *
- * Voir aussi:
- * - `afd_ajouter_transition(AFD, int, char, int)`
- * - `afd_init(int, int, int, const int*, const char*)`
+ * Alloue la fonction de transition de l'AFD spécifié, de `A->nbClasses` colonnes, dans son arène ;
+ * toutes les transitions valent `INVALID_STATE`.
  */
-AFD afd_init_owned(int Q, int q0, int *F, int lenF, char *Sigma, int lenSigma) {
+static void afd_allouer_delta(AFD A) {
+	const size_t nbCases = (size_t) (A->Q + 1) * A->nbClasses;
+	
+	// les lignes de `delta` sont contiguës, prises dans l'arène de l'AFD
+	A->memoire = arena_new_empty();
+	A->delta = arena_alloc(&A->memoire, (A->Q + 1) * sizeof(int*));
+	int *cases = arena_alloc(&A->memoire, nbCases * sizeof(int));
+	
+	for(size_t i = 0; i < nbCases; ++i) {
+		cases[i] = INVALID_STATE;
+	}
+	
+	for(int q = 0; q <= A->Q; ++q) {
+		A->delta[q] = &cases[(size_t) q * A->nbClasses];
+	}
+}
+
+
+/**
+ * Comme `afd_init_owned(int, int, int*, int, char*, int)`, le symbole `Sigma[i]` utilisant la colonne `classes[i]`
+ * (parmi `nbClasses`) de la fonction de transition ; si `classes` vaut `NULL`, chaque symbole a sa propre colonne.
+ */
+static AFD afd_init_owned_classes(int Q, int q0, int *F, int lenF, char *Sigma, int lenSigma, const int *classes, int nbClasses) {
 	check_param("Q", Q >= 0);
 	check_param("q0", q0 >= 0 && q0 <= Q);
-	check_param("F", F != NULL);
-	check_param("lenF", lenF > 0);
+	check_param("F", F != NULL || lenF == 0);
+	check_param("lenF", lenF >= 0);
 	check_param("Sigma", Sigma != NULL);
 	check_param("lenSigma", lenSigma > 0);
+	check_param("nbClasses", classes == NULL || (nbClasses > 0 && nbClasses <= lenSigma));
 	
 	AFD A = checked_malloc(sizeof(struct AFD));
 	A->Q = Q;
@@ -41,22 +50,46 @@ AFD afd_init_owned(int Q, int q0, int *F, int lenF, char *Sigma, int lenSigma) {
 	A->lenF = lenF;
 	A->Sigma = Sigma;
 	A->lenSigma = lenSigma;
+	A->nbClasses = (classes == NULL) ? lenSigma : nbClasses;
 	
 	af_init_dico(A->dico, Sigma, lenSigma);
 	
-	A->delta = checked_malloc((Q + 1) * sizeof(int*));
-	for(int q = 0; q <= Q; ++q) {
-		A->delta[q] = checked_malloc(lenSigma * sizeof(int));
-		
-		for(int s = 0; s < lenSigma; ++s) {
-			A->delta[q][s] = INVALID_STATE;
+	if(classes != NULL) {
+		for(int i = 0; i < lenSigma; ++i) {
+			check_param("classes[i]", classes[i] >= 0 && classes[i] < nbClasses);
+			A->dico[Sigma[i] - ASCII_FIRST] = classes[i];
 		}
 	}
 	
+	afd_allouer_delta(A);
 	return A;
 }
 
 
+/**
+ * Initialise et renvoie un nouvel AFD à partir de sa définition sans effectuer de copie.
+ *
+ * Paramètres:
+ * - Q        : le plus grand état
+ * - q0       : l'état initial
+ * - F        : un tableau des états finaux
+ * - lenF     : le nombre d'états finaux
+ * - Sigma    : une chaîne de caractères terminée par '\0' qui représentera l'alphabet
+ * - lenSigma : le nombre de symboles dans l'alphabet
+ *
+ * Remarques:
+ * - La fonction de transition de l'automate est allouée mais indéfinie dans le nouvel AFD.
+ * - Le comportement si un état final est présent deux fois dans `listFinals` est indéfini.
+ *
+ * Voir aussi:
+ * - `afd_ajouter_transition(AFD, int, char, int)`
+ * - `afd_init(int, int, int, const int*, const char*)`
+ */
+AFD afd_init_owned(int Q, int q0, int *F, int lenF, char *Sigma, int lenSigma) {
+	return afd_init_owned_classes(Q, q0, F, lenF, Sigma, lenSigma, NULL, 0);
+}
+
+
 /**
  * Initialise et renvoie un nouvel AFD à partir de sa définition.
  *
@@ -75,25 +108,43 @@ AFD afd_init_owned(int Q, int q0, int *F, int lenF, char *Sigma, int lenSigma) {
  * - `afd_ajouter_transition(AFD, int, char, int)`
  */
 AFD afd_init(int Q, int q0, int nbFinals, const int *listFinals, const char *Sigma) {
-	check_param("nbFinals", nbFinals > 0);
-	check_param("listFinals", listFinals != NULL);
+	return afd_init_classes(Q, q0, nbFinals, listFinals, Sigma, NULL, 0);
+}
+
+
+/**
+ * Initialise et renvoie un nouvel AFD dont les symboles sont regroupés en `nbClasses` classes : le symbole
+ * `Sigma[i]` utilise la colonne `classes[i]` de la fonction de transition, allouée avec `nbClasses` colonnes.
+ *
+ * Si `classes` vaut `NULL`, chaque symbole a sa propre colonne, comme avec `afd_init(int, int, int, const int*, const char*)`.
+ */
+AFD afd_init_classes(int Q, int q0, int nbFinals, const int *listFinals, const char *Sigma, const int *classes, int nbClasses) {
+	check_param("nbFinals", nbFinals >= 0);
+	check_param("listFinals", listFinals != NULL || nbFinals == 0);
 	check_param("Sigma", Sigma != NULL);
 	
 	int lenSigma = strlen(Sigma);
 	check_param("strlen(Sigma)", lenSigma > 0);
 	
-	int *F = checked_malloc(nbFinals * sizeof(int));
-	memcpy(F, listFinals, nbFinals * sizeof(int));
+	// un AFD peut n'avoir aucun état final (langage vide, p. ex. après déterminisation)
+	int *F = NULL;
+	if(nbFinals > 0) {
+		F = checked_malloc(nbFinals * sizeof(int));
+		memcpy(F, listFinals, nbFinals * sizeof(int));
+	}
 	
 	char *S = checked_malloc(lenSigma + 1);
 	memcpy(S, Sigma, lenSigma + 1);
 	
-	return afd_init_owned(Q, q0, F, nbFinals, S, lenSigma);
+	return afd_init_owned_classes(Q, q0, F, nbFinals, S, lenSigma, classes, nbClasses);
 }
 
 
 /**
  * Modifie la fonction de transition de l'AFD spécifié de façon à ce que δ(q1, s) = q2.
+ *
+ * Remarque:
+ * - Sur un AFD compressé, la transition est modifiée pour tous les symboles de la classe de `s`.
  */
 void afd_ajouter_transition(AFD A, int q1, char s, int q2) {
 	check_param("q1", q1 >= 0 && q1 <= A->Q);
@@ -181,6 +232,10 @@ int afd_simuler(AFD A, const char *s) {
 		}
 		
 		q = A->delta[q][s];
+		if(q == INVALID_STATE) {
+			// la transition mène vers l'état puits implicite
+			return 0;
+		}
 	}
 	
 	// on regarde si q0.s est dans les états finaux
@@ -194,6 +249,332 @@ int afd_simuler(AFD A, const char *s) {
 }
 
 
+/**
+ * Construit et renvoie l'AFD minimal reconnaissant le même langage que l'AFD spécifié (algorithme de Hopcroft).
+ *
+ * Les états du nouvel AFD sont renumérotés dans l'ordre d'un parcours en largeur depuis son état initial ;
+ * les états inaccessibles disparaissent, et les états ne menant à aucun état final sont remplacés par des
+ * transitions `INVALID_STATE`.
+ */
+AFD afd_minimiser(AFD A) {
+	// l'état puits implicite devient un état explicite `puits`, ce qui rend la fonction de transition totale
+	const int n = A->Q + 2;
+	const int puits = A->Q + 1;
+	const int k = A->nbClasses;
+	
+	// index inverse : les prédécesseurs de `t` par le symbole d'indice `s`
+	// sont `inv[inv_debut[s * n + t]]` ... `inv[inv_debut[s * n + t + 1] - 1]`
+	int *inv_debut = checked_malloc((k * n + 1) * sizeof(int));
+	int *inv = checked_malloc(k * n * sizeof(int));
+	
+	for(int i = 0; i <= k * n; ++i) {
+		inv_debut[i] = 0;
+	}
+	
+	for(int q = 0; q < n; ++q) {
+		for(int s = 0; s < k; ++s) {
+			int t = (q == puits || A->delta[q][s] == INVALID_STATE) ? puits : A->delta[q][s];
+			++inv_debut[s * n + t + 1];
+		}
+	}
+	
+	for(int i = 0; i < k * n; ++i) {
+		inv_debut[i + 1] += inv_debut[i];
+	}
+	
+	int *remplis = checked_malloc(k * n * sizeof(int));
+	memcpy(remplis, inv_debut, k * n * sizeof(int));
+	
+	for(int q = 0; q < n; ++q) {
+		for(int s = 0; s < k; ++s) {
+			int t = (q == puits || A->delta[q][s] == INVALID_STATE) ? puits : A->delta[q][s];
+			inv[remplis[s * n + t]++] = q;
+		}
+	}
+	
+	free(remplis);
+	
+	// partition des états : le bloc `b` est constitué des états `elems[debut[b]]` ... `elems[fin[b] - 1]`,
+	// dont les `marques[b]` premiers sont marqués ; `pos[q]` est l'indice de `q` dans `elems`
+	int *elems = checked_malloc(n * sizeof(int));
+	int *pos = checked_malloc(n * sizeof(int));
+	int *bloc = checked_malloc(n * sizeof(int));
+	int *debut = checked_malloc(n * sizeof(int));
+	int *fin = checked_malloc(n * sizeof(int));
+	int *marques = checked_malloc(n * sizeof(int));
+	int nbBlocs = 0;
+	
+	// partition initiale : les états finaux d'un côté, les autres de l'autre
+	char *final = checked_malloc(n);
+	memset(final, 0, n);
+	for(int i = 0; i < A->lenF; ++i) {
+		final[A->F[i]] = 1;
+	}
+	
+	int len = 0;
+	for(int f = 1; f >= 0; --f) {
+		int premier = len;
+		
+		for(int q = 0; q < n; ++q) {
+			if(final[q] == f) {
+				elems[len] = q;
+				pos[q] = len;
+				bloc[q] = nbBlocs;
+				++len;
+			}
+		}
+		
+		if(len > premier) {
+			debut[nbBlocs] = premier;
+			fin[nbBlocs] = len;
+			marques[nbBlocs] = 0;
+			++nbBlocs;
+		}
+	}
+	
+	// liste des couples (bloc, symbole) servant encore de séparateurs, à raison de deux entiers par couple ;
+	// initialement, le plus petit des deux blocs suffit
+	stack attente = stack_new_empty();
+	if(nbBlocs == 2) {
+		int b = (fin[0] - debut[0] <= fin[1] - debut[1]) ? 0 : 1;
+		
+		for(int s = 0; s < k; ++s) {
+			stack_push(&attente, b);
+			stack_push(&attente, s);
+		}
+	}
+	
+	int *separateur = checked_malloc(n * sizeof(int));
+	stack touches = stack_new_empty();
+	
+	while(!stack_is_empty(attente)) {
+		int s = stack_pop(&attente);
+		int b = stack_pop(&attente);
+		
+		// copie du bloc séparateur, qui peut être réordonné pendant le marquage
+		int taille = fin[b] - debut[b];
+		memcpy(separateur, &elems[debut[b]], taille * sizeof(int));
+		
+		// marquage des prédécesseurs par `s` des états du bloc séparateur
+		for(int i = 0; i < taille; ++i) {
+			int t = separateur[i];
+			
+			for(int j = inv_debut[s * n + t]; j < inv_debut[s * n + t + 1]; ++j) {
+				int p = inv[j];
+				int c = bloc[p];
+				
+				// on échange `p` avec le premier état non marqué de son bloc
+				int i1 = pos[p];
+				int i2 = debut[c] + marques[c];
+				int r = elems[i2];
+				
+				elems[i1] = r;
+				pos[r] = i1;
+				elems[i2] = p;
+				pos[p] = i2;
+				
+				if(marques[c]++ == 0) {
+					stack_push(&touches, c);
+				}
+			}
+		}
+		
+		// séparation des blocs partiellement marqués
+		while(!stack_is_empty(touches)) {
+			int c = stack_pop(&touches);
+			int m = marques[c];
+			marques[c] = 0;
+			
+			if(m == fin[c] - debut[c]) {
+				continue;
+			}
+			
+			// le nouveau bloc est la plus petite des deux parties, ce qui borne le nombre de renommages
+			int nb = nbBlocs++;
+			
+			if(m <= fin[c] - debut[c] - m) {
+				debut[nb] = debut[c];
+				fin[nb] = debut[c] + m;
+				debut[c] += m;
+			}
+			else {
+				debut[nb] = debut[c] + m;
+				fin[nb] = fin[c];
+				fin[c] = debut[c] + m;
+			}
+			
+			marques[nb] = 0;
+			for(int i = debut[nb]; i < fin[nb]; ++i) {
+				bloc[elems[i]] = nb;
+			}
+			
+			// que `c` soit encore en attente ou non, il suffit d'ajouter la plus petite partie
+			for(int s2 = 0; s2 < k; ++s2) {
+				stack_push(&attente, nb);
+				stack_push(&attente, s2);
+			}
+		}
+	}
+	
+	// renumérotation des blocs accessibles depuis l'état initial ; le bloc du puits n'est pas conservé
+	// (s'il contient un état final, ce n'est pas un puits : il reste alors un état comme les autres)
+	int mort = final[puits] ? -1 : bloc[puits];
+	
+	int *nom = separateur;
+	for(int b = 0; b < nbBlocs; ++b) {
+		nom[b] = INVALID_STATE;
+	}
+	
+	stack ordre = stack_new_empty();
+	if(bloc[A->q0] != mort) {
+		nom[bloc[A->q0]] = 0;
+		stack_push(&ordre, bloc[A->q0]);
+	}
+	
+	for(size_t i = 0; i < ordre.len; ++i) {
+		int q = elems[debut[ordre.buf[i]]];
+		
+		for(int s = 0; s < k; ++s) {
+			int t = (q == puits || A->delta[q][s] == INVALID_STATE) ? puits : A->delta[q][s];
+			int c = bloc[t];
+			
+			if(c != mort && nom[c] == INVALID_STATE) {
+				nom[c] = (int) ordre.len;
+				stack_push(&ordre, c);
+			}
+		}
+	}
+	
+	// construction du nouvel AFD ; si le langage est vide, il ne reste qu'un état initial non final
+	stack F = stack_new_empty();
+	for(size_t i = 0; i < ordre.len; ++i) {
+		if(final[elems[debut[ordre.buf[i]]]]) {
+			stack_push(&F, (int) i);
+		}
+	}
+	
+	int Q = (ordre.len == 0) ? 0 : (int) ordre.len - 1;
+	// le nouvel AFD garde les classes de symboles de `A`
+	int *classes = checked_malloc(A->lenSigma * sizeof(int));
+	for(int i = 0; i < A->lenSigma; ++i) {
+		classes[i] = A->dico[A->Sigma[i] - ASCII_FIRST];
+	}
+	
+	AFD M = afd_init_classes(Q, 0, (int) F.len, F.buf, A->Sigma, classes, k);
+	free(classes);
+	
+	for(size_t i = 0; i < ordre.len; ++i) {
+		int q = elems[debut[ordre.buf[i]]];
+		
+		for(int s = 0; s < k; ++s) {
+			int t = (q == puits || A->delta[q][s] == INVALID_STATE) ? puits : A->delta[q][s];
+			
+			// `M` a les mêmes classes que `A`, donc les colonnes sont identiques
+			M->delta[i][s] = (bloc[t] == mort) ? INVALID_STATE : nom[bloc[t]];
+		}
+	}
+	
+	stack_free(&F);
+	stack_free(&ordre);
+	stack_free(&touches);
+	stack_free(&attente);
+	free(separateur);
+	free(final);
+	free(marques);
+	free(fin);
+	free(debut);
+	free(bloc);
+	free(pos);
+	free(elems);
+	free(inv);
+	free(inv_debut);
+	return M;
+}
+
+
+/**
+ * Renvoie `1` si les colonnes `s1` et `s2` de la fonction de transition de l'AFD spécifié sont identiques, sinon `0`.
+ */
+static int afd_colonnes_egales(AFD A, int s1, int s2) {
+	for(int q = 0; q <= A->Q; ++q) {
+		if(A->delta[q][s1] != A->delta[q][s2]) {
+			return 0;
+		}
+	}
+	
+	return 1;
+}
+
+
+/**
+ * Regroupe en classes les symboles de même comportement de l'AFD spécifié, c.-à-d. dont les colonnes de la
+ * fonction de transition sont identiques : `dico` associe ensuite chaque symbole à sa classe, et chaque ligne de
+ * `delta` n'a plus qu'une colonne par classe. Renvoie le nombre de classes.
+ *
+ * Le langage reconnu ne change pas ; la table, plus petite, tient plus souvent dans les caches du processeur.
+ */
+int afd_compresser(AFD A) {
+	const int k = A->nbClasses;
+	
+	// empreinte de chaque colonne (FNV-1a) : seules les colonnes de même empreinte sont comparées entièrement
+	size_t *empreinte = checked_malloc(k * sizeof(size_t));
+	for(int s = 0; s < k; ++s) {
+		size_t h = (size_t) 14695981039346656037ULL;
+		
+		for(int q = 0; q <= A->Q; ++q) {
+			h = (h ^ (unsigned int) A->delta[q][s]) * (size_t) 1099511628211ULL;
+		}
+		
+		empreinte[s] = h;
+	}
+	
+	// `classe[s]` : la nouvelle colonne de l'ancienne colonne `s` ; `representant[c]` : une ancienne colonne de la classe `c`
+	int *classe = checked_malloc(k * sizeof(int));
+	int *representant = checked_malloc(k * sizeof(int));
+	int nbClasses = 0;
+	
+	for(int s = 0; s < k; ++s) {
+		int c = 0;
+		while(c < nbClasses && (empreinte[representant[c]] != empreinte[s] || !afd_colonnes_egales(A, representant[c], s))) {
+			++c;
+		}
+		
+		if(c == nbClasses) {
+			representant[nbClasses++] = s;
+		}
+		
+		classe[s] = c;
+	}
+	
+	if(nbClasses < k) {
+		// la nouvelle table est recopiée dans une nouvelle arène, puis l'ancienne est libérée
+		arena ancienne = A->memoire;
+		int **delta = A->delta;
+		
+		A->nbClasses = nbClasses;
+		afd_allouer_delta(A);
+		
+		for(int q = 0; q <= A->Q; ++q) {
+			for(int c = 0; c < nbClasses; ++c) {
+				A->delta[q][c] = delta[q][representant[c]];
+			}
+		}
+		
+		arena_free(&ancienne);
+		
+		for(int i = 0; i < A->lenSigma; ++i) {
+			int *d = &A->dico[A->Sigma[i] - ASCII_FIRST];
+			*d = classe[*d];
+		}
+	}
+	
+	free(empreinte);
+	free(classe);
+	free(representant);
+	return nbClasses;
+}
+
+
 /**
  * Affiche l'AFD spécifié dans le flux de sortie standard.
  */
@@ -251,11 +632,6 @@ void afd_print(AFD A){
 void afd_free(AFD A) {
 	free(A->F);
 	free(A->Sigma);
-	
-	for(int q = 0; q <= A->Q; ++q) {
-		free(A->delta[q]);
-	}
-	
-	free(A->delta);
+	arena_free(&A->memoire);
 	free(A);
 }
@@ -3,6 +3,8 @@
 
 #include "af.h"
 
+#include "util/arena.h"
+
 /**
  * Représente un automate fini déterministe (AFD).
  *
@@ -44,23 +46,41 @@ struct AFD {
 	 */
 	int lenSigma;
 	
+	/**
+	 * Le nombre de classes de symboles, c.-à-d. de colonnes de `delta` (`nbClasses <= lenSigma`).
+	 *
+	 * Des symboles de même comportement (les mêmes transitions depuis chaque état) peuvent partager une colonne ;
+	 * sinon, chaque symbole a la sienne et `nbClasses == lenSigma`.
+	 *
+	 * Voir aussi:
+	 * - `afd_compresser(AFD)`
+	 */
+	int nbClasses;
+	
 	/**
 	 * La fonction de transition de l'automate.
 	 * δ(q, τ) = delta[q][dico[τ - ASCII_FIRST]]
 	 *
-	 * La fonction est définie pout tout état q et pour tout symbole τ dans Σ.
+	 * Une case peut valoir `INVALID_STATE` : la transition mène alors vers un état puits implicite.
 	 */
 	int **delta;
 	
 	/**
-	 * Ce tableau permet de récupérer l'indice du symbole τ dans l'alphabet Σ.
+	 * L'arène dont proviennent `delta` et ses lignes, libérée d'un seul coup par `afd_free(AFD)`.
+	 */
+	arena memoire;
+	
+	/**
+	 * Ce tableau permet de récupérer la colonne de `delta` du symbole τ, c.-à-d. sa classe ; tant que l'AFD
+	 * n'est pas compressé, c'est l'indice du symbole τ dans l'alphabet Σ.
 	 *
 	 * Exemple:
 	 * ```
-	 * Sigma := "ab"
+	 * Sigma := "abc", où 'a' et 'c' ont le même comportement
 	 * dico['a' - ASCII_FIRST] =  0
 	 * dico['b' - ASCII_FIRST] =  1
-	 * dico['c' - ASCII_FIRST] = -1
+	 * dico['c' - ASCII_FIRST] =  0
+	 * dico['d' - ASCII_FIRST] = -1
 	 * ```
 	 */
 	int dico[MAX_SYMBOLES];
@@ -89,8 +109,20 @@ typedef struct AFD* AFD;
 AFD afd_init(int Q, int q0, int nbFinals, const int *listFinals, const char *Sigma);
 
 
+/**
+ * Initialise et renvoie un nouvel AFD dont les symboles sont regroupés en `nbClasses` classes : le symbole
+ * `Sigma[i]` utilise la colonne `classes[i]` de la fonction de transition, allouée avec `nbClasses` colonnes.
+ *
+ * Si `classes` vaut `NULL`, chaque symbole a sa propre colonne, comme avec `afd_init(int, int, int, const int*, const char*)`.
+ */
+AFD afd_init_classes(int Q, int q0, int nbFinals, const int *listFinals, const char *Sigma, const int *classes, int nbClasses);
+
+
 /**
  * Modifie la fonction de transition de l'AFD spécifié de façon à ce que δ(q1, s) = q2.
+ *
+ * Remarque:
+ * - Sur un AFD compressé, la transition est modifiée pour tous les symboles de la classe de `s`.
  */
 void afd_ajouter_transition(AFD A, int q1, char s, int q2);
 
@@ -118,6 +150,26 @@ AFD afd_finit(char *filename);
 int afd_simuler(AFD A, const char *s);
 
 
+/**
+ * Construit et renvoie l'AFD minimal reconnaissant le même langage que l'AFD spécifié (algorithme de Hopcroft).
+ *
+ * Les états du nouvel AFD sont renumérotés dans l'ordre d'un parcours en largeur depuis son état initial ;
+ * les états inaccessibles disparaissent, et les états ne menant à aucun état final sont remplacés par des
+ * transitions `INVALID_STATE`.
+ */
+AFD afd_minimiser(AFD A);
+
+
+/**
+ * Regroupe en classes les symboles de même comportement de l'AFD spécifié, c.-à-d. dont les colonnes de la
+ * fonction de transition sont identiques : `dico` associe ensuite chaque symbole à sa classe, et chaque ligne de
+ * `delta` n'a plus qu'une colonne par classe. Renvoie le nombre de classes.
+ *
+ * Le langage reconnu ne change pas ; la table, plus petite, tient plus souvent dans les caches du processeur.
+ */
+int afd_compresser(AFD A);
+
+
 /**
  * Affiche l'AFD spécifié dans le flux de sortie standard.
  */
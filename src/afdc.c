@@ -0,0 +1,489 @@
+#include "afdc.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "util/misc.h"
+
+/**
+ * Le nombre d'octets lus entre deux vérifications de l'état mort dans `afdc_simuler_n()`.
+ */
+#define AFDC_BLOC 256
+
+/**
+ * La taille minimale d'un morceau de `afdc_simuler_parallele()` : en deçà, créer un thread coûte plus cher
+ * que de simuler le morceau.
+ */
+#define AFDC_MORCEAU_MIN (1 << 16)
+
+/**
+ * Le nombre de chaînes simulées simultanément par `afdc_simuler_lot()`.
+ */
+#define AFDC_VOIES 8
+
+/**
+ * Renvoie l'état représentant la transition vers `q2` dans la table (voir `afdc_compiler_colonne()`),
+ * ou `-1` pour l'état mort.
+ */
+static inline int afdc_cible(const int *cible, int q2) {
+	return (q2 == INVALID_STATE) ? -1 : cible[q2];
+}
+
+
+/**
+ * Compile l'AFD spécifié en une table de transition dont la colonne des octets hors de l'alphabet
+ * mène à l'état `inconnu`, ou à l'état mort si `inconnu` vaut `-1`.
+ *
+ * La table a une colonne par classe de symboles de l'AFD (voir `afd_compresser(AFD)`) ; la colonne morte est
+ * confondue avec une classe qui mène depuis chaque état là où elle mènerait, s'il y en a une.
+ */
+static AFDC afdc_compiler_colonne(AFD A, int inconnu) {
+	const int k = A->nbClasses;
+	
+	// `cible[q]` : l'état de l'AFD représentant `q` dans la table, ou `-1` pour l'état mort ; sans état `inconnu`,
+	// les puits de l'AFD (non finaux, ne menant qu'à eux-mêmes, p. ex. l'ensemble vide d'une déterminisation)
+	// sont confondus avec l'état mort
+	int *cible = checked_malloc((A->Q + 1) * sizeof(int));
+	for(int q = 0; q <= A->Q; ++q) {
+		cible[q] = q;
+		
+		if(inconnu != -1) {
+			continue;
+		}
+		
+		int s = 0;
+		while(s < k && (A->delta[q][s] == q || A->delta[q][s] == INVALID_STATE)) {
+			++s;
+		}
+		
+		if(s == k) {
+			cible[q] = -1;
+		}
+	}
+	
+	for(int i = 0; i < A->lenF; ++i) {
+		cible[A->F[i]] = A->F[i];
+	}
+	
+	// la colonne morte est la première classe menant partout à `inconnu` (ou à l'état mort), sinon une nouvelle colonne
+	int colonneMorte = 0;
+	for(; colonneMorte < k; ++colonneMorte) {
+		int q = 0;
+		while(q <= A->Q && afdc_cible(cible, A->delta[q][colonneMorte]) == inconnu) {
+			++q;
+		}
+		
+		if(q > A->Q) {
+			break;
+		}
+	}
+	
+	AFDC T = checked_malloc(sizeof(struct AFDC));
+	T->nbEtats = A->Q + 2;
+	T->nbColonnes = (colonneMorte < k) ? k : (k + 1);
+	
+	check_param("A->nbClasses", T->nbColonnes <= 256);
+	
+	const int w = T->nbColonnes;
+	
+	T->q0 = (cible[A->q0] == -1) ? (T->nbEtats - 1) * w : A->q0 * w;
+	T->mort = (T->nbEtats - 1) * w;
+	
+	// tous les octets mènent à la colonne morte, sauf ceux de l'alphabet
+	for(int c = 0; c < 256; ++c) {
+		T->colonne[c] = (unsigned char) colonneMorte;
+	}
+	
+	for(int i = 0; i < A->lenSigma; ++i) {
+		char c = A->Sigma[i];
+		T->colonne[(unsigned char) c] = (unsigned char) A->dico[c - ASCII_FIRST];
+	}
+	
+	T->delta = checked_malloc((size_t) T->nbEtats * w * sizeof(int));
+	for(int q = 0; q <= A->Q; ++q) {
+		int *ligne = &T->delta[(size_t) q * w];
+		
+		for(int s = 0; s < k; ++s) {
+			int q2 = A->delta[q][s];
+			ligne[s] = (afdc_cible(cible, q2) == -1) ? T->mort : (q2 * w);
+		}
+		
+		ligne[colonneMorte] = (inconnu == -1) ? T->mort : (inconnu * w);
+	}
+	
+	// l'état mort boucle sur lui-même
+	for(int s = 0; s < w; ++s) {
+		T->delta[T->mort + s] = T->mort;
+	}
+	
+	T->projection = NULL;
+	T->lenProjection = 0;
+	
+	T->finals = checked_malloc((size_t) T->nbEtats * w);
+	memset(T->finals, 0, (size_t) T->nbEtats * w);
+	for(int i = 0; i < A->lenF; ++i) {
+		T->finals[(size_t) A->F[i] * w] = 1;
+	}
+	
+	free(cible);
+	return T;
+}
+
+
+/**
+ * Compile l'AFD spécifié en une table de transition ; l'AFD peut être libéré ensuite.
+ */
+AFDC afdc_compiler(AFD A) {
+	return afdc_compiler_colonne(A, -1);
+}
+
+
+/**
+ * Compile l'AFD spécifié en une table de transition destinée à la recherche : les octets qui ne sont pas
+ * dans l'alphabet de l'AFD ramènent à l'état initial au lieu de l'état mort.
+ *
+ * L'AFD doit reconnaître un langage de la forme Σ*L (voir `afn_prefixer(AFN)`), pour lequel lire un symbole
+ * inconnu de L revient à recommencer la recherche.
+ */
+AFDC afdc_compiler_recherche(AFD A) {
+	return afdc_compiler_colonne(A, A->q0);
+}
+
+
+/**
+ * Renvoie `1` si les `n` premiers octets de `s` forment un mot accepté par l'AFDC spécifié, sinon renvoie `0`.
+ */
+int afdc_simuler_n(AFDC T, const char *s, size_t n) {
+	const int *delta = T->delta;
+	const unsigned char *colonne = T->colonne;
+	const unsigned char *p = (const unsigned char*) s;
+	const unsigned char *end = p + n;
+	
+	int q = T->q0;
+	
+	// la boucle interne ne contient aucun branchement dépendant des données :
+	// l'état mort n'est détecté qu'entre deux blocs
+	while(p != end) {
+		const unsigned char *bloc = (end - p > AFDC_BLOC) ? (p + AFDC_BLOC) : end;
+		
+		while(p != bloc) {
+			q = delta[q + colonne[*p++]];
+		}
+		
+		if(q == T->mort) {
+			return 0;
+		}
+	}
+	
+	return T->finals[q];
+}
+
+
+/**
+ * Renvoie `1` si la chaîne spécifiée est acceptée par l'AFDC spécifié, sinon renvoie `0`.
+ */
+int afdc_simuler(AFDC T, const char *s) {
+	return afdc_simuler_n(T, s, strlen(s));
+}
+
+
+/**
+ * Renvoie la position de fin (exclue) du plus court préfixe accepté des `n` premiers octets de `s`,
+ * ou `-1` si aucun préfixe n'est accepté.
+ *
+ * Sur une table de recherche, c'est la fin de la première occurrence de L dans `s`.
+ */
+long afdc_rechercher(AFDC T, const char *s, size_t n) {
+	const int *delta = T->delta;
+	const unsigned char *colonne = T->colonne;
+	const unsigned char *finals = T->finals;
+	const unsigned char *p = (const unsigned char*) s;
+	
+	int q = T->q0;
+	if(finals[q]) {
+		return 0;
+	}
+	
+	for(size_t i = 0; i < n; ++i) {
+		q = delta[q + colonne[p[i]]];
+		
+		if(finals[q]) {
+			return (long) i + 1;
+		}
+	}
+	
+	return -1;
+}
+
+
+/**
+ * Lit les `n` premiers octets de `s` de droite à gauche, et renvoie la longueur du plus long suffixe dont
+ * le miroir est accepté par l'AFDC spécifié, ou `-1` si aucun ne l'est.
+ */
+long afdc_rechercher_arriere(AFDC T, const char *s, size_t n) {
+	const int *delta = T->delta;
+	const unsigned char *colonne = T->colonne;
+	const unsigned char *p = (const unsigned char*) s;
+	
+	int q = T->q0;
+	long plusLong = T->finals[q] ? 0 : -1;
+	
+	// la lecture s'arrête dès l'état mort : aucun suffixe plus long ne peut être accepté
+	for(size_t i = n; i > 0 && q != T->mort; --i) {
+		q = delta[q + colonne[p[i - 1]]];
+		
+		if(T->finals[q]) {
+			plusLong = (long) (n - i) + 1;
+		}
+	}
+	
+	return plusLong;
+}
+
+
+/**
+ * Simule l'AFDC spécifié sur les `nb` chaînes de `s`, et écrit dans `resultats[i]` le résultat (`1` si acceptée,
+ * sinon `0`) de la chaîne `s[i]`, de longueur `n[i]` (ou terminée par '\0' si `n` vaut `NULL`).
+ *
+ * Les chaînes sont simulées par groupes de `AFDC_VOIES`, un octet de chacune à tour de rôle jusqu'à la fin de la
+ * plus courte du groupe : les lectures de `delta` des différentes chaînes sont indépendantes et se recouvrent, au
+ * lieu d'attendre chacune la précédente. La fin de chaque chaîne est ensuite lue seule.
+ */
+void afdc_simuler_lot(AFDC T, const char **s, const size_t *n, size_t nb, unsigned char *resultats) {
+	const int *delta = T->delta;
+	const unsigned char *colonne = T->colonne;
+	
+	size_t g = 0;
+	for(; g + AFDC_VOIES <= nb; g += AFDC_VOIES) {
+		const unsigned char *p[AFDC_VOIES];
+		size_t len[AFDC_VOIES];
+		int q[AFDC_VOIES];
+		
+		size_t m = SIZE_MAX;
+		for(int k = 0; k < AFDC_VOIES; ++k) {
+			p[k] = (const unsigned char*) s[g + k];
+			len[k] = (n != NULL) ? n[g + k] : strlen(s[g + k]);
+			q[k] = T->q0;
+			
+			if(len[k] < m) {
+				m = len[k];
+			}
+		}
+		
+		// aucune voie ne se termine avant `m` : la boucle interne ne contient aucun branchement
+		size_t i = 0;
+		for(; i < m; ++i) {
+			for(int k = 0; k < AFDC_VOIES; ++k) {
+				q[k] = delta[q[k] + colonne[p[k][i]]];
+			}
+		}
+		
+		for(int k = 0; k < AFDC_VOIES; ++k) {
+			for(size_t j = i; j < len[k]; ++j) {
+				q[k] = delta[q[k] + colonne[p[k][j]]];
+			}
+			
+			resultats[g + k] = T->finals[q[k]];
+		}
+	}
+	
+	for(; g < nb; ++g) {
+		resultats[g] = afdc_simuler_n(T, s[g], (n != NULL) ? n[g] : strlen(s[g]));
+	}
+}
+
+
+/**
+ * Représente un morceau de texte simulé par un thread de `afdc_simuler_parallele()`.
+ */
+typedef struct {
+	AFDC T;
+	const unsigned char *debut;
+	size_t n;
+	
+	/**
+	 * Le nombre d'états de départ : `1` pour le premier morceau (l'état initial), `nbEtats` sinon (tous les états).
+	 */
+	int nbDepart;
+	
+	/**
+	 * `fin[i]` : l'état (prémultiplié) atteint à la fin du morceau depuis le `i`-ème état de départ.
+	 */
+	int *fin;
+} Morceau;
+
+
+/**
+ * Simule un morceau depuis tous ses états de départ à la fois.
+ *
+ * Les simulations issues de départs différents convergent souvent vers un même état : seuls les états actifs
+ * distincts sont avancés, et ils sont fusionnés à la fin de chaque bloc. Dès qu'il n'en reste qu'un seul, le
+ * morceau est achevé comme une simulation ordinaire.
+ */
+static void* afdc_simuler_morceau(void *arg) {
+	Morceau *M = arg;
+	const AFDC T = M->T;
+	const int *delta = T->delta;
+	const unsigned char *colonne = T->colonne;
+	const unsigned char *p = M->debut;
+	const unsigned char *end = p + M->n;
+	
+	// `fin[i]` désigne d'abord l'indice dans `actifs` de l'état atteint depuis le `i`-ème départ
+	int *actifs = checked_malloc(M->nbDepart * sizeof(int));
+	int *nouveau = checked_malloc(M->nbDepart * sizeof(int));
+	int *indice = checked_malloc(T->nbEtats * sizeof(int));
+	int nbActifs = M->nbDepart;
+	
+	for(int i = 0; i < M->nbDepart; ++i) {
+		actifs[i] = (M->nbDepart == 1) ? T->q0 : i * T->nbColonnes;
+		M->fin[i] = i;
+	}
+	
+	for(int k = 0; k < T->nbEtats; ++k) {
+		indice[k] = -1;
+	}
+	
+	while(p != end && nbActifs > 1) {
+		const unsigned char *bloc = (end - p > AFDC_BLOC) ? (p + AFDC_BLOC) : end;
+		
+		// les simulations sont indépendantes : leurs lectures de `delta` se recouvrent
+		for(; p != bloc; ++p) {
+			const int c = colonne[*p];
+			for(int a = 0; a < nbActifs; ++a) {
+				actifs[a] = delta[actifs[a] + c];
+			}
+		}
+		
+		// fusion des états actifs identiques
+		int n = 0;
+		for(int a = 0; a < nbActifs; ++a) {
+			int k = actifs[a] / T->nbColonnes;
+			if(indice[k] == -1) {
+				indice[k] = n;
+				actifs[n++] = actifs[a];
+			}
+			
+			nouveau[a] = indice[k];
+		}
+		
+		for(int a = 0; a < n; ++a) {
+			indice[actifs[a] / T->nbColonnes] = -1;
+		}
+		
+		for(int i = 0; i < M->nbDepart; ++i) {
+			M->fin[i] = nouveau[M->fin[i]];
+		}
+		
+		nbActifs = n;
+	}
+	
+	if(nbActifs == 1) {
+		// comme dans `afdc_simuler_n()`, l'état mort (absorbant) n'est détecté qu'entre deux blocs
+		int q = actifs[0];
+		while(p != end && q != T->mort) {
+			const unsigned char *bloc = (end - p > AFDC_BLOC) ? (p + AFDC_BLOC) : end;
+			
+			while(p != bloc) {
+				q = delta[q + colonne[*p++]];
+			}
+		}
+		
+		actifs[0] = q;
+	}
+	
+	for(int i = 0; i < M->nbDepart; ++i) {
+		M->fin[i] = actifs[M->fin[i]];
+	}
+	
+	free(actifs);
+	free(nouveau);
+	free(indice);
+	return NULL;
+}
+
+
+/**
+ * Renvoie `1` si les `n` premiers octets de `s` forment un mot accepté par l'AFDC spécifié, sinon renvoie `0`,
+ * en découpant `s` en `nbThreads` morceaux simulés en parallèle.
+ *
+ * Le premier morceau est simulé depuis l'état initial ; chacun des suivants l'est depuis tous les états à la fois,
+ * ce qui donne la fonction de transition du morceau entier. Composer ces fonctions donne exactement le résultat de
+ * `afdc_simuler_n()`.
+ *
+ * Remarque:
+ * - Le gain suppose que les simulations d'un morceau depuis des états différents convergent rapidement vers un
+ *   même état, ce qui est le cas de la plupart des AFD ; sinon, un morceau coûte jusqu'à `nbEtats` fois plus cher.
+ * - Les textes trop courts pour être découpés en morceaux d'au moins 64 Kio sont simulés par `afdc_simuler_n()`.
+ */
+int afdc_simuler_parallele(AFDC T, const char *s, size_t n, int nbThreads) {
+	if(nbThreads > 1 && n / AFDC_MORCEAU_MIN < (size_t) nbThreads) {
+		nbThreads = (int) (n / AFDC_MORCEAU_MIN);
+	}
+	
+	if(nbThreads <= 1) {
+		return afdc_simuler_n(T, s, n);
+	}
+	
+	Morceau *M = checked_malloc(nbThreads * sizeof(Morceau));
+	pthread_t *threads = checked_malloc(nbThreads * sizeof(pthread_t));
+	int *lance = checked_malloc(nbThreads * sizeof(int));
+	
+	const size_t taille = n / nbThreads;
+	for(int k = 0; k < nbThreads; ++k) {
+		M[k].T = T;
+		M[k].debut = (const unsigned char*) s + k * taille;
+		M[k].n = (k == nbThreads - 1) ? (n - k * taille) : taille;
+		M[k].nbDepart = (k == 0) ? 1 : T->nbEtats;
+		M[k].fin = checked_malloc(M[k].nbDepart * sizeof(int));
+	}
+	
+	// le premier morceau est simulé par le thread appelant ; un morceau dont le thread n'a pas pu être créé aussi
+	for(int k = 1; k < nbThreads; ++k) {
+		lance[k] = pthread_create(&threads[k], NULL, afdc_simuler_morceau, &M[k]) == 0;
+	}
+	
+	afdc_simuler_morceau(&M[0]);
+	
+	for(int k = 1; k < nbThreads; ++k) {
+		if(lance[k]) {
+			pthread_join(threads[k], NULL);
+		}
+		else {
+			afdc_simuler_morceau(&M[k]);
+		}
+	}
+	
+	int q = M[0].fin[0];
+	for(int k = 1; k < nbThreads; ++k) {
+		q = M[k].fin[q / T->nbColonnes];
+	}
+	
+	for(int k = 0; k < nbThreads; ++k) {
+		free(M[k].fin);
+	}
+	
+	free(M);
+	free(threads);
+	free(lance);
+	return T->finals[q];
+}
+
+
+/**
+ * Libère les ressources allouées à un AFDC.
+ */
+void afdc_free(AFDC T) {
+	if(T->projection != NULL) {
+		munmap(T->projection, T->lenProjection);
+	}
+	else {
+		free(T->delta);
+		free(T->finals);
+	}
+	
+	free(T);
+}
@@ -0,0 +1,145 @@
+#ifndef AFDC_H
+#define AFDC_H
+
+#include <stddef.h>
+
+#include "afd.h"
+
+/**
+ * Représente un AFD compilé (AFDC) en une table de transition contiguë, destinée à la simulation.
+ *
+ * Les états sont prémultipliés : l'état d'indice `q` est représenté par `q * nbColonnes`, ce qui fait
+ * de chaque transition une seule lecture `delta[q + colonne[c]]` sans multiplication.
+ *
+ * Les colonnes sont celles des classes de symboles de l'AFD (voir `afd_compresser(AFD)`). Une colonne morte reçoit
+ * tous les octets qui ne sont pas dans l'alphabet de l'AFD : c'est une classe de même comportement s'il y en a une,
+ * sinon une colonne supplémentaire. Le dernier état (état mort) remplace toutes les transitions `INVALID_STATE` de l'AFD.
+ */
+struct AFDC {
+	/**
+	 * Le nombre d'états de la table, état mort compris.
+	 */
+	int nbEtats;
+	
+	/**
+	 * Le nombre de colonnes de la table, colonne morte comprise.
+	 */
+	int nbColonnes;
+	
+	/**
+	 * L'état initial (prémultiplié).
+	 */
+	int q0;
+	
+	/**
+	 * L'état mort (prémultiplié) : aucun état final n'est accessible depuis celui-ci.
+	 */
+	int mort;
+	
+	/**
+	 * La colonne associée à chaque octet.
+	 */
+	unsigned char colonne[256];
+	
+	/**
+	 * La fonction de transition : δ(q, c) = delta[q + colonne[c]] pour tout état prémultiplié `q`.
+	 */
+	int *delta;
+	
+	/**
+	 * `finals[q]` vaut `1` si l'état prémultiplié `q` est final, sinon `0` ; le tableau est indexé directement
+	 * par les états prémultipliés afin d'éviter une division à chaque octet lors d'une recherche.
+	 */
+	unsigned char *finals;
+	
+	/**
+	 * La projection en mémoire du fichier dont proviennent `delta` et `finals`, ou `NULL` s'ils ont été alloués ;
+	 * `lenProjection` est sa taille en octets.
+	 *
+	 * Voir aussi:
+	 * - `binaire_charger_afdc(const char*, int)`
+	 */
+	void *projection;
+	size_t lenProjection;
+};
+
+typedef struct AFDC* AFDC;
+
+
+/**
+ * Compile l'AFD spécifié en une table de transition ; l'AFD peut être libéré ensuite.
+ */
+AFDC afdc_compiler(AFD A);
+
+
+/**
+ * Compile l'AFD spécifié en une table de transition destinée à la recherche : les octets qui ne sont pas
+ * dans l'alphabet de l'AFD ramènent à l'état initial au lieu de l'état mort.
+ *
+ * L'AFD doit reconnaître un langage de la forme Σ*L (voir `afn_prefixer(AFN)`), pour lequel lire un symbole
+ * inconnu de L revient à recommencer la recherche.
+ */
+AFDC afdc_compiler_recherche(AFD A);
+
+
+/**
+ * Renvoie `1` si les `n` premiers octets de `s` forment un mot accepté par l'AFDC spécifié, sinon renvoie `0`.
+ */
+int afdc_simuler_n(AFDC T, const char *s, size_t n);
+
+
+/**
+ * Renvoie `1` si la chaîne spécifiée est acceptée par l'AFDC spécifié, sinon renvoie `0`.
+ */
+int afdc_simuler(AFDC T, const char *s);
+
+
+/**
+ * Simule l'AFDC spécifié sur les `nb` chaînes de `s`, et écrit dans `resultats[i]` le résultat (`1` si acceptée,
+ * sinon `0`) de la chaîne `s[i]`, de longueur `n[i]` (ou terminée par '\0' si `n` vaut `NULL`).
+ *
+ * Les chaînes sont simulées par groupes de 8, un octet de chacune à tour de rôle jusqu'à la fin de la
+ * plus courte du groupe : les lectures de `delta` des différentes chaînes sont indépendantes et se recouvrent, au
+ * lieu d'attendre chacune la précédente. La fin de chaque chaîne est ensuite lue seule.
+ */
+void afdc_simuler_lot(AFDC T, const char **s, const size_t *n, size_t nb, unsigned char *resultats);
+
+
+/**
+ * Renvoie `1` si les `n` premiers octets de `s` forment un mot accepté par l'AFDC spécifié, sinon renvoie `0`,
+ * en découpant `s` en `nbThreads` morceaux simulés en parallèle.
+ *
+ * Le premier morceau est simulé depuis l'état initial ; chacun des suivants l'est depuis tous les états à la fois,
+ * ce qui donne la fonction de transition du morceau entier. Composer ces fonctions donne exactement le résultat de
+ * `afdc_simuler_n()`.
+ *
+ * Remarque:
+ * - Le gain suppose que les simulations d'un morceau depuis des états différents convergent rapidement vers un
+ *   même état, ce qui est le cas de la plupart des AFD ; sinon, un morceau coûte jusqu'à `nbEtats` fois plus cher.
+ * - Les textes trop courts pour être découpés en morceaux d'au moins 64 Kio sont simulés par `afdc_simuler_n()`.
+ */
+int afdc_simuler_parallele(AFDC T, const char *s, size_t n, int nbThreads);
+
+
+/**
+ * Renvoie la position de fin (exclue) du plus court préfixe accepté des `n` premiers octets de `s`,
+ * ou `-1` si aucun préfixe n'est accepté.
+ *
+ * Sur une table de recherche, c'est la fin de la première occurrence de L dans `s`.
+ */
+long afdc_rechercher(AFDC T, const char *s, size_t n);
+
+
+/**
+ * Lit les `n` premiers octets de `s` de droite à gauche, et renvoie la longueur du plus long suffixe dont
+ * le miroir est accepté par l'AFDC spécifié, ou `-1` si aucun ne l'est.
+ */
+long afdc_rechercher_arriere(AFDC T, const char *s, size_t n);
+
+
+/**
+ * Libère les ressources allouées à un AFDC.
+ */
+void afdc_free(AFDC T);
+
+#endif // AFDC_H
@@ -0,0 +1,240 @@
+#include "afdp.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "util/misc.h"
+
+/**
+ * Initialise et renvoie un nouvel AFD paresseux simulant l'AFN spécifié avec un cache d'au plus `budget` octets.
+ */
+AFDP afdp_init(AFN A, size_t budget) {
+	check_param("A", A != NULL);
+	check_param("budget", budget > 0);
+	
+	AFDP L = checked_malloc(sizeof(struct AFDP));
+	L->A = A;
+	L->budget = budget;
+	L->octets = 0;
+	L->etats = setmap_new_empty();
+	L->delta = NULL;
+	L->finals = NULL;
+	L->capacity = 0;
+	
+	L->initial = set_copy_from(A->I, A->lenI);
+	afn_epsilon_closure_assign(A, &L->initial);
+	
+	L->F = set_copy_from(A->F, A->lenF);
+	
+	L->vu = checked_malloc((A->Q + 1) * sizeof(int));
+	for(int q = 0; q <= A->Q; ++q) {
+		L->vu[q] = -1;
+	}
+	L->marque = 0;
+	
+	L->hits = 0;
+	L->misses = 0;
+	L->vidages = 0;
+	L->replis = 0;
+	
+	return L;
+}
+
+
+/**
+ * Renvoie l'espace mémoire (en octets) qu'occupera dans le cache l'état représenté par l'ensemble `S`.
+ */
+static size_t afdp_taille_etat(AFDP L, set S) {
+	return L->A->lenSigma * sizeof(int) + sizeof(char)             // `delta` et `finals`
+		+ sizeof(set) + sizeof(size_t) + 2 * sizeof(int)           // `etats`
+		+ S.len * sizeof(int);                                     // l'ensemble lui-même
+}
+
+
+/**
+ * Renvoie un marqueur libre pour `afn_successeurs()`.
+ */
+static int afdp_marque(AFDP L) {
+	if(L->marque == INT_MAX) {
+		for(int q = 0; q <= L->A->Q; ++q) {
+			L->vu[q] = -1;
+		}
+		
+		L->marque = 0;
+	}
+	
+	return L->marque++;
+}
+
+
+/**
+ * Renvoie l'état du cache correspondant à l'ensemble `*S`, en l'y ajoutant s'il n'y est pas encore.
+ * Le cache prend possession de `*S` s'il est ajouté (voir `setmap_intern()`).
+ */
+static int afdp_etat(AFDP L, set *S) {
+	size_t taille = afdp_taille_etat(L, *S);
+	
+	int nouveau;
+	int d = setmap_intern(&L->etats, S, &nouveau);
+	
+	if(nouveau) {
+		if(L->etats.len > L->capacity) {
+			L->capacity = (L->capacity == 0) ? 16 : (L->capacity * 2);
+			L->delta = checked_realloc(L->delta, L->capacity * L->A->lenSigma * sizeof(int));
+			L->finals = checked_realloc(L->finals, L->capacity * sizeof(char));
+		}
+		
+		int *ligne = &L->delta[(size_t) d * L->A->lenSigma];
+		for(int s = 0; s < L->A->lenSigma; ++s) {
+			ligne[s] = INVALID_STATE;
+		}
+		
+		L->finals[d] = set_are_intersecting(L->etats.cles[d], L->F);
+		L->octets += taille;
+	}
+	
+	return d;
+}
+
+
+/**
+ * Simule l'AFN sans cache à partir de l'ensemble d'états `R` sur la chaîne `s` ; libère `R`.
+ * Renvoie `1` si la chaîne est acceptée depuis `R`, sinon renvoie `0`.
+ */
+static int afdp_simuler_afn(AFDP L, set R, const char *s) {
+	AFN A = L->A;
+	
+	char c;
+	for(size_t i = 0; (c = s[i]) != '\0'; ++i) {
+		int col = (c < ASCII_FIRST || c > ASCII_LAST || c == EPSILON) ? -1 : A->dico[c - ASCII_FIRST];
+		if(col == -1) {
+			set_free(&R);
+			return 0;
+		}
+		
+		set next = afn_successeurs(A, R, col, L->vu, afdp_marque(L));
+		afn_epsilon_closure_assign(A, &next);
+		
+		set_free(&R);
+		R = next;
+	}
+	
+	int accepted = set_are_intersecting(R, L->F);
+	set_free(&R);
+	return accepted;
+}
+
+
+/**
+ * Renvoie `1` si la chaîne spécifiée est acceptée par l'AFN de l'AFDP spécifié, sinon renvoie `0`.
+ */
+int afdp_simuler(AFDP L, const char *s) {
+	AFN A = L->A;
+	const int w = A->lenSigma;
+	
+	int d = setmap_get(&L->etats, L->initial);
+	if(d == -1) {
+		set I = set_copy_from(L->initial.buf, L->initial.len);
+		d = afdp_etat(L, &I);
+		set_free(&I);
+	}
+	
+	// nombre de caractères lus et de transitions calculées depuis le dernier vidage,
+	// et nombre de vidages consécutifs survenus alors que le cache manquait plus d'une fois sur deux
+	size_t lus = 0;
+	size_t manques = 0;
+	int rapproches = 0;
+	
+	char c;
+	for(size_t i = 0; (c = s[i]) != '\0'; ++i) {
+		// vérification des caractères qui ne seront jamais acceptés par un AFN
+		if(c < ASCII_FIRST || c > ASCII_LAST || c == EPSILON) {
+			return 0;
+		}
+		
+		int col = A->dico[c - ASCII_FIRST];
+		if(col == -1) {
+			return 0;
+		}
+		
+		++lus;
+		
+		int next = L->delta[(size_t) d * w + col];
+		if(next != INVALID_STATE) {
+			++(L->hits);
+			d = next;
+			continue;
+		}
+		
+		++(L->misses);
+		++manques;
+		
+		set R = afn_successeurs(A, L->etats.cles[d], col, L->vu, afdp_marque(L));
+		afn_epsilon_closure_assign(A, &R);
+		
+		int vide = 0;
+		if(L->octets + afdp_taille_etat(L, R) > L->budget && L->etats.len > 0) {
+			rapproches = (2 * manques > lus) ? (rapproches + 1) : 0;
+			lus = 0;
+			manques = 0;
+			
+			afdp_vider(L);
+			++(L->vidages);
+			vide = 1;
+			
+			if(rapproches >= AFDP_VIDAGES_MAX) {
+				// le cache ne fait que se remplir et se vider : on termine la chaîne sur l'AFN
+				++(L->replis);
+				return afdp_simuler_afn(L, R, s + i + 1);
+			}
+		}
+		
+		next = afdp_etat(L, &R);
+		set_free(&R);
+		
+		// après un vidage, l'état `d` n'existe plus dans le cache
+		if(!vide) {
+			L->delta[(size_t) d * w + col] = next;
+		}
+		
+		d = next;
+	}
+	
+	return L->finals[d];
+}
+
+
+/**
+ * Vide le cache de l'AFDP spécifié.
+ */
+void afdp_vider(AFDP L) {
+	setmap_clear(&L->etats);
+	L->octets = 0;
+}
+
+
+/**
+ * Affiche les compteurs de l'AFDP spécifié dans le flux de sortie standard.
+ */
+void afdp_print_stats(AFDP L) {
+	printf("états en cache = %zu (%zu octets, %zu octets au total)\n", L->etats.len, L->octets, setmap_memory(&L->etats) + L->capacity * (L->A->lenSigma * sizeof(int) + sizeof(char)));
+	printf("hits = %zu, misses = %zu\n", L->hits, L->misses);
+	printf("vidages = %zu, replis = %zu\n", L->vidages, L->replis);
+}
+
+
+/**
+ * Libère les ressources allouées à un AFDP (mais pas son AFN).
+ */
+void afdp_free(AFDP L) {
+	setmap_free(&L->etats);
+	set_free(&L->initial);
+	set_free(&L->F);
+	
+	free(L->delta);
+	free(L->finals);
+	free(L->vu);
+	free(L);
+}
@@ -0,0 +1,132 @@
+#ifndef AFDP_H
+#define AFDP_H
+
+#include <stddef.h>
+
+#include "afn.h"
+
+#include "util/setmap.h"
+
+/**
+ * Le nombre de vidages consécutifs trop rapprochés à partir duquel un AFDP abandonne son cache
+ * pour la fin de la chaîne en cours et simule directement l'AFN.
+ */
+#define AFDP_VIDAGES_MAX 3
+
+/**
+ * Représente un AFD paresseux (AFDP) : les états de l'AFD équivalent à un AFN sont construits à la
+ * demande pendant la lecture, puis mémorisés dans un cache de taille bornée.
+ *
+ * Chaque état du cache est un ensemble d'états de l'AFN, clos par epsilon-transitions.
+ */
+struct AFDP {
+	/**
+	 * L'AFN simulé ; il n'appartient pas à l'AFDP et doit lui survivre.
+	 */
+	AFN A;
+	
+	/**
+	 * La taille maximale (en octets) du cache avant qu'il ne soit vidé.
+	 */
+	size_t budget;
+	
+	/**
+	 * L'espace mémoire (en octets) actuellement occupé par le cache.
+	 */
+	size_t octets;
+	
+	/**
+	 * Les états déjà construits, c.-à-d. des ensembles d'états de l'AFN.
+	 */
+	setmap etats;
+	
+	/**
+	 * La fonction de transition déjà calculée.
+	 * δ(d, τ) = delta[d * A->lenSigma + A->dico[τ - ASCII_FIRST]], ou `INVALID_STATE` si elle n'a pas encore été calculée.
+	 */
+	int *delta;
+	
+	/**
+	 * `finals[d]` vaut `1` si l'état `d` contient un état final de l'AFN, sinon `0`.
+	 */
+	char *finals;
+	
+	/**
+	 * Le nombre d'états pour lesquels `delta` et `finals` ont de la place.
+	 */
+	size_t capacity;
+	
+	/**
+	 * L'epsilon-fermeture des états initiaux de l'AFN.
+	 */
+	set initial;
+	
+	/**
+	 * Les états finaux de l'AFN.
+	 */
+	set F;
+	
+	/**
+	 * Un tableau de `A->Q + 1` marqueurs utilisé par `afn_successeurs()`.
+	 */
+	int *vu;
+	
+	/**
+	 * Le prochain marqueur libre dans `vu`.
+	 */
+	int marque;
+	
+	/**
+	 * Le nombre de transitions trouvées dans le cache.
+	 */
+	size_t hits;
+	
+	/**
+	 * Le nombre de transitions qui ont dû être calculées.
+	 */
+	size_t misses;
+	
+	/**
+	 * Le nombre de fois où le cache a été vidé car il dépassait `budget`.
+	 */
+	size_t vidages;
+	
+	/**
+	 * Le nombre de chaînes dont la fin a été simulée directement sur l'AFN.
+	 */
+	size_t replis;
+};
+
+typedef struct AFDP* AFDP;
+
+
+/**
+ * Initialise et renvoie un nouvel AFD paresseux simulant l'AFN spécifié avec un cache d'au plus `budget` octets.
+ */
+AFDP afdp_init(AFN A, size_t budget);
+
+
+/**
+ * Renvoie `1` si la chaîne spécifiée est acceptée par l'AFN de l'AFDP spécifié, sinon renvoie `0`.
+ */
+int afdp_simuler(AFDP L, const char *s);
+
+
+/**
+ * Vide le cache de l'AFDP spécifié.
+ */
+void afdp_vider(AFDP L);
+
+
+/**
+ * Affiche les compteurs de l'AFDP spécifié dans le flux de sortie standard.
+ */
+void afdp_print_stats(AFDP L);
+
+
+/**
+ * Libère les ressources allouées à un AFDP (mais pas son AFN).
+ */
+void afdp_free(AFDP L);
+
+#endif // AFDP_H
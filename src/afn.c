@@ -1,12 +1,15 @@
 #include "afn.h"
 
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <sys/mman.h>
 
 #include "util/stack.h"
 #include "util/misc.h"
+#include "util/stats.h"
 
 /**
  * Initialise et renvoie un nouvel AFN à partir de sa définition sans effectuer de copie.
@@ -27,8 +30,8 @@ AFN afn_init_owned(int Q, int *I, int lenI, int *F, int lenF, char *Sigma, int l
 	check_param("Q", Q >= 0);
 	check_param("I", I != NULL);
 	check_param("lenI", lenI > 0);
-	check_param("F", F != NULL);
-	check_param("lenF", lenF > 0);
+	check_param("F", F != NULL || lenF == 0);
+	check_param("lenF", lenF >= 0);
 	check_param("Sigma", Sigma != NULL);
 	check_param("lenSigma", lenSigma > 0);
 	
@@ -55,13 +58,18 @@ AFN afn_init_owned(int Q, int *I, int lenI, int *F, int lenF, char *Sigma, int l
 	
 	af_init_dico(A->dico, Sigma, lenSigma);
 	
-	A->delta = checked_malloc((Q + 1) * sizeof(int**));
+	A->csr = NULL;
+	A->sansEpsilon = 0;
+	A->projection = NULL;
+	A->lenProjection = 0;
+	
+	// les lignes de `delta` sont contiguës, prises dans l'arène de l'AFN comme toutes les listes de transitions
+	A->memoire = arena_new_empty();
+	A->delta = arena_alloc(&A->memoire, (Q + 1) * sizeof(int**));
+	int **cases = arena_calloc(&A->memoire, (size_t) (Q + 1) * lenSigma * sizeof(int*));
+	
 	for(int q = 0; q <= Q; ++q) {
-		A->delta[q] = checked_malloc(lenSigma * sizeof(int*));
-		
-		for(int s = 0; s < lenSigma; ++s) {
-			A->delta[q][s] = NULL;
-		}
+		A->delta[q] = &cases[(size_t) q * lenSigma];
 	}
 	
 	return A;
@@ -126,6 +134,10 @@ AFN afn_init(int Q, int nbInitiaux, const int *listInitiaux, int nbFinals, const
 
 /**
  * Modifie la fonction de transition de l'AFN spécifié de façon à ce que Δ(q1, s) contienne l'état q2.
+ *
+ * Remarque:
+ * - La liste Δ(q1, s) est réallouée dans l'arène de l'AFN à chaque appel, l'ancienne n'étant libérée que par
+ *   `afn_free(AFN)` ; pour ajouter de nombreuses transitions, préférer `afn_ajouter_transitions(AFN, tbuf*)`.
  */
 void afn_ajouter_transition(AFN A, int q1, char c, int q2) {
 	check_param("q1", q1 >= 0 && q1 <= A->Q);
@@ -138,10 +150,19 @@ void afn_ajouter_transition(AFN A, int q1, char c, int q2) {
 		exit(1);
 	}
 	
+	if(A->csr != NULL) {
+		fprintf(stderr, "afn_ajouter_transition(): l'AFN est figé\n");
+		exit(1);
+	}
+	
+	if(c == EPSILON) {
+		A->sansEpsilon = 0;
+	}
+	
 	int **transitions = &(A->delta[q1][s]);
 	
 	if(*transitions == NULL) {
-		*transitions = checked_malloc(2 * sizeof(int));
+		*transitions = arena_alloc(&A->memoire, 2 * sizeof(int));
 		(*transitions)[0] = q2;
 		(*transitions)[1] = INVALID_STATE;
 	}
@@ -151,17 +172,212 @@ void afn_ajouter_transition(AFN A, int q1, char c, int q2) {
 			++count;
 		}
 		
-		int *new_transitions = checked_malloc((count + 2) * sizeof(int));
+		int *new_transitions = arena_alloc(&A->memoire, (count + 2) * sizeof(int));
 		memcpy(new_transitions, *transitions, count * sizeof(int));
 		new_transitions[count] = q2;
 		new_transitions[count + 1] = INVALID_STATE;
 		
-		free(*transitions);
 		*transitions = new_transitions;
 	}
 }
 
 
+/**
+ * Ajoute à l'AFN spécifié toutes les transitions du tampon `T`, puis vide ce tampon.
+ *
+ * Les transitions sont regroupées par paire (q, τ) et dédoublonnées, si bien que chaque liste Δ(q, τ) modifiée
+ * n'est allouée qu'une seule fois, fusionnée avec les transitions déjà présentes dans l'AFN.
+ */
+void afn_ajouter_transitions(AFN A, tbuf *T) {
+	if(A->csr != NULL) {
+		fprintf(stderr, "afn_ajouter_transitions(): l'AFN est figé\n");
+		exit(1);
+	}
+	
+	// vérification des transitions, et reprise dans le tampon des listes déjà présentes dans l'AFN
+	const size_t n = T->len;
+	for(size_t i = 0; i < n; ++i) {
+		// copie, car `tbuf_push()` peut réallouer le tampon
+		transition t = T->buf[i];
+		
+		check_param("q1", t.q1 >= 0 && t.q1 <= A->Q);
+		check_param("c", t.c >= ASCII_FIRST && t.c <= ASCII_LAST);
+		check_param("q2", t.q2 >= 0 && t.q2 <= A->Q);
+		
+		int s = A->dico[t.c - ASCII_FIRST];
+		if(s == -1) {
+			fprintf(stderr, "afn_ajouter_transitions(): '%c' n'appartient pas à \"%s\"\n", t.c, A->Sigma);
+			exit(1);
+		}
+		
+		if(t.c == EPSILON) {
+			A->sansEpsilon = 0;
+		}
+		
+		int *q2 = A->delta[t.q1][s];
+		if(q2 != NULL) {
+			for(int *p = q2; *p != INVALID_STATE; ++p) {
+				tbuf_push(T, t.q1, t.c, *p);
+			}
+			
+			// l'ancienne liste reste dans l'arène jusqu'à `afn_free()`
+			A->delta[t.q1][s] = NULL;
+		}
+	}
+	
+	// tri des états d'arrivée par paire `p = q1 * lenSigma + s` : les listes sont ensuite construites dans l'ordre
+	// des paires, en parcourant `delta` séquentiellement plutôt qu'au hasard des transitions
+	const size_t nbPaires = (size_t) (A->Q + 1) * A->lenSigma;
+	check_param("T->len", T->len < INT_MAX);
+	
+	// `debut[p + 1]` : d'abord le nombre de transitions de la paire `p`, puis la fin de ses transitions dans `dest`
+	int *debut = checked_malloc((nbPaires + 1) * sizeof(int));
+	memset(debut, 0, (nbPaires + 1) * sizeof(int));
+	
+	for(size_t i = 0; i < T->len; ++i) {
+		++debut[(size_t) T->buf[i].q1 * A->lenSigma + A->dico[T->buf[i].c - ASCII_FIRST] + 1];
+	}
+	
+	for(size_t p = 0; p < nbPaires; ++p) {
+		debut[p + 1] += debut[p];
+	}
+	
+	// `debut[p]` sert de curseur, et vaut ensuite la fin des transitions de la paire `p`
+	int *dest = checked_malloc((T->len + 1) * sizeof(int));
+	for(size_t i = 0; i < T->len; ++i) {
+		dest[debut[(size_t) T->buf[i].q1 * A->lenSigma + A->dico[T->buf[i].c - ASCII_FIRST]]++] = T->buf[i].q2;
+	}
+	
+	// chaque liste est allouée une seule fois, sans doublon, puis terminée par `INVALID_STATE`
+	int *vu = checked_malloc((A->Q + 1) * sizeof(int));
+	for(int q = 0; q <= A->Q; ++q) {
+		vu[q] = -1;
+	}
+	
+	int d = 0;
+	for(int q = 0; q <= A->Q; ++q) {
+		for(int s = 0; s < A->lenSigma; ++s) {
+			const int fin = debut[(size_t) q * A->lenSigma + s];
+			if(fin == d) {
+				continue;
+			}
+			
+			int *q2 = arena_alloc(&A->memoire, (fin - d + 1) * sizeof(int));
+			int len = 0;
+			
+			// `d`, l'indice de la première transition de la paire, identifie la paire dans `vu`
+			for(int k = d; k < fin; ++k) {
+				if(vu[dest[k]] != d) {
+					vu[dest[k]] = d;
+					q2[len++] = dest[k];
+				}
+			}
+			
+			q2[len] = INVALID_STATE;
+			A->delta[q][s] = q2;
+			d = fin;
+		}
+	}
+	
+	free(vu);
+	free(dest);
+	free(debut);
+	tbuf_clear(T);
+}
+
+
+/**
+ * Fige l'AFN spécifié : sa fonction de transition est recopiée au format CSR, que les fonctions de simulation
+ * parcourent ensuite séquentiellement. Un AFN figé ne peut plus recevoir de nouvelles transitions.
+ */
+void afn_figer(AFN A) {
+	if(A->csr != NULL) {
+		return;
+	}
+	
+	// dénombrement des paires et des transitions
+	int nbPaires = 0;
+	int lenDest = 0;
+	
+	for(int q = 0; q <= A->Q; ++q) {
+		for(int s = 0; s < A->lenSigma; ++s) {
+			int *q2 = A->delta[q][s];
+			
+			if(q2 != NULL && *q2 != INVALID_STATE) {
+				++nbPaires;
+				
+				while(*q2 != INVALID_STATE) {
+					++lenDest;
+					++q2;
+				}
+				
+				++lenDest;
+			}
+		}
+	}
+	
+	struct CSR *csr = checked_malloc(sizeof(struct CSR));
+	csr->nbPaires = nbPaires;
+	csr->lenDest = lenDest;
+	csr->ligne = checked_malloc((A->Q + 2) * sizeof(int));
+	csr->symbole = checked_malloc((nbPaires + 1) * sizeof(int));
+	csr->debut = checked_malloc((nbPaires + 1) * sizeof(int));
+	csr->dest = checked_malloc((lenDest + 1) * sizeof(int));
+	
+	// recopie dans l'ordre croissant des états puis des symboles
+	int p = 0;
+	int d = 0;
+	
+	for(int q = 0; q <= A->Q; ++q) {
+		csr->ligne[q] = p;
+		
+		for(int s = 0; s < A->lenSigma; ++s) {
+			int *q2 = A->delta[q][s];
+			
+			if(q2 != NULL && *q2 != INVALID_STATE) {
+				csr->symbole[p] = s;
+				csr->debut[p] = d;
+				++p;
+				
+				while(*q2 != INVALID_STATE) {
+					csr->dest[d++] = *q2;
+					++q2;
+				}
+				
+				csr->dest[d++] = INVALID_STATE;
+			}
+		}
+	}
+	
+	csr->ligne[A->Q + 1] = p;
+	csr->debut[p] = d;
+	
+	A->csr = csr;
+}
+
+
+/**
+ * Renvoie Δ(q, s) sous la forme d'une liste terminée par `INVALID_STATE`, ou `NULL` si elle est vide,
+ * `s` étant l'indice du symbole dans `Sigma` ; utilise la forme figée de l'AFN si elle existe.
+ */
+static inline const int* afn_transitions(AFN A, int q, int s) {
+	const struct CSR *csr = A->csr;
+	
+	if(csr == NULL) {
+		return A->delta[q][s];
+	}
+	
+	// les symboles d'une ligne sont triés, et une ligne ne contient en général que quelques paires
+	for(int p = csr->ligne[q]; p < csr->ligne[q + 1]; ++p) {
+		if(csr->symbole[p] >= s) {
+			return (csr->symbole[p] == s) ? &csr->dest[csr->debut[p]] : NULL;
+		}
+	}
+	
+	return NULL;
+}
+
+
 /**
  * Initialise et renvoie un nouvel AFN à partir d'un fichier `filename` écrit au format :
  * ```
@@ -212,12 +428,18 @@ AFN afn_finit(const char *filename) {
 	
 	AFN A = afn_init_owned(Q, I, lenI, F, lenF, Sigma, lenSigma);
 	
+	// les transitions sont accumulées puis ajoutées en une seule fois
+	tbuf T = tbuf_new_empty();
+	
 	int q1 = -1, q2 = -1;
 	char c = '\0';
 	while(fparse_transition(f, filename, &line, &buf, &bufCapacity, &q1, &c, &q2)) {
-		afn_ajouter_transition(A, q1, c, q2);
+		tbuf_push(&T, q1, c, q2);
 	}
 	
+	afn_ajouter_transitions(A, &T);
+	tbuf_free(&T);
+	
 	fclose(f);
 	free(rpath);
 	free(buf);
@@ -229,12 +451,18 @@ AFN afn_finit(const char *filename) {
  * Calcul l'epsilon-fermeture d'un ensemble d'états `G` passé en paramètre; écrit ce résultat dans cedit paramètre.
  */
 void afn_epsilon_closure_assign(AFN A, set *G) {
+	if(A->sansEpsilon) {
+		return;
+	}
+	
+	STATS_AJOUTER(fermetures, 1);
+	
 	stack accessible = stack_copy_from(G->buf, G->len);
 	
 	while(!stack_is_empty(accessible)) {
 		int q = stack_pop(&accessible);
 		
-		int *q2 = A->delta[q][A->dico[EPSILON - ASCII_FIRST]];
+		const int *q2 = afn_transitions(A, q, A->dico[EPSILON - ASCII_FIRST]);
 		if(q2 == NULL) {
 			continue;
 		}
@@ -248,6 +476,9 @@ void afn_epsilon_closure_assign(AFN A, set *G) {
 		}
 	}
 	
+	STATS_AJOUTER(fermeturesEtats, G->len);
+	STATS_MAX(fermetureMax, G->len);
+	
 	stack_free(&accessible);
 }
 
@@ -319,22 +550,14 @@ int afn_simuler(AFN A, const char *s) {
 		
 		for(size_t j = 0; j < R.len; ++j) {
 			// pour toutes les transitions possibles en lisant `c` (d'indice `s` dans `Sigma`) dans un état particulier de `R`,
-			int *q2 = A->delta[R.buf[j]][s];
+			const int *q2 = afn_transitions(A, R.buf[j], s);
 			
 			if(q2 != NULL) {
-				// on converti la liste des transitions possibles en un ensemble,
-				set next = set_new_empty();
+				// on ajoute les états accessibles dans `R_next`, la liste étant contiguë en mémoire
 				while(*q2 != INVALID_STATE) {
-					set_push(&next, *q2);
+					set_push(&R_next, *q2);
 					++q2;
 				}
-				
-				// et on ajoute les états accessibles dans `R_next`
-				set _union = set_union(R_next, next);
-				
-				set_free(&R_next);
-				set_free(&next);
-				R_next = _union;
 			}
 		}
 		
@@ -343,6 +566,10 @@ int afn_simuler(AFN A, const char *s) {
 		
 		R = R_next;
 		afn_epsilon_closure_assign(A, &R);
+		
+		STATS_AJOUTER(octets, 1);
+		STATS_AJOUTER(actifs, R.len);
+		STATS_MAX(actifsMax, R.len);
 	}
 	
 	// `s` appartient à l'AFN si et seulement si un de nos états dans l'epsilon-fermeture de `R` appartient aux états finaux
@@ -356,6 +583,343 @@ int afn_simuler(AFN A, const char *s) {
 }
 
 
+/**
+ * Compare deux entiers pour `qsort()`.
+ */
+static int int_cmp(const void *lhs, const void *rhs) {
+	int a = *(const int*) lhs;
+	int b = *(const int*) rhs;
+	
+	return (a > b) - (a < b);
+}
+
+
+/**
+ * Calcul l'ensemble des états accessibles depuis `R` en lisant le symbole d'indice `s` dans `Sigma`,
+ * sans epsilon-fermeture.
+ *
+ * Paramètres:
+ * - vu    : un tableau de `Q + 1` marqueurs, tous différents de `marque` à l'appel
+ * - marque: la valeur utilisée pour marquer les états déjà ajoutés
+ */
+set afn_successeurs(AFN A, set R, int s, int *vu, int marque) {
+	stack next = stack_new_empty();
+	
+	for(size_t j = 0; j < R.len; ++j) {
+		const int *q2 = afn_transitions(A, R.buf[j], s);
+		if(q2 == NULL) {
+			continue;
+		}
+		
+		while(*q2 != INVALID_STATE) {
+			if(vu[*q2] != marque) {
+				vu[*q2] = marque;
+				stack_push(&next, *q2);
+			}
+			
+			++q2;
+		}
+	}
+	
+	// une pile triée et sans doublon est un ensemble valide
+	if(next.len > 1) {
+		qsort(next.buf, next.len, sizeof(int), int_cmp);
+	}
+	
+	set S;
+	S.buf = next.buf;
+	S.len = next.len;
+	S.capacity = next.capacity;
+	return S;
+}
+
+
+/**
+ * Renvoie `1` si les listes de transitions spécifiées, terminées par `INVALID_STATE` ou `NULL` si vides,
+ * sont identiques, sinon `0`.
+ */
+static int afn_listes_egales(const int *l1, const int *l2) {
+	if(l1 == NULL || l2 == NULL) {
+		return (l1 == NULL || *l1 == INVALID_STATE) && (l2 == NULL || *l2 == INVALID_STATE);
+	}
+	
+	while(*l1 == *l2 && *l1 != INVALID_STATE) {
+		++l1;
+		++l2;
+	}
+	
+	return *l1 == *l2;
+}
+
+
+/**
+ * Regroupe en classes les `n` colonnes `colonnes[0]`, ..., `colonnes[n - 1]` de l'AFN spécifié : deux colonnes
+ * sont dans la même classe si elles ont la même liste de transitions depuis chaque état.
+ *
+ * Écrit dans `classes[j]` la classe de la colonne `colonnes[j]`, et dans `representants[c]` l'indice `j` d'une
+ * colonne de la classe `c` ; renvoie le nombre de classes.
+ */
+static int afn_classes(AFN A, const int *colonnes, int n, int *classes, int *representants) {
+	// empreinte de chaque colonne (FNV-1a) : seules les colonnes de même empreinte sont comparées entièrement
+	size_t *empreinte = checked_malloc(n * sizeof(size_t));
+	for(int j = 0; j < n; ++j) {
+		size_t h = (size_t) 14695981039346656037ULL;
+		
+		for(int q = 0; q <= A->Q; ++q) {
+			const int *q2 = afn_transitions(A, q, colonnes[j]);
+			
+			while(q2 != NULL && *q2 != INVALID_STATE) {
+				h = (h ^ (unsigned int) *q2++) * (size_t) 1099511628211ULL;
+			}
+			
+			// séparateur entre deux états
+			h = (h ^ (unsigned int) INVALID_STATE) * (size_t) 1099511628211ULL;
+		}
+		
+		empreinte[j] = h;
+	}
+	
+	int nbClasses = 0;
+	for(int j = 0; j < n; ++j) {
+		int c = 0;
+		
+		for(; c < nbClasses; ++c) {
+			const int r = representants[c];
+			if(empreinte[r] != empreinte[j]) {
+				continue;
+			}
+			
+			int q = 0;
+			while(q <= A->Q && afn_listes_egales(afn_transitions(A, q, colonnes[r]), afn_transitions(A, q, colonnes[j]))) {
+				++q;
+			}
+			
+			if(q > A->Q) {
+				break;
+			}
+		}
+		
+		if(c == nbClasses) {
+			representants[nbClasses++] = j;
+		}
+		
+		classes[j] = c;
+	}
+	
+	free(empreinte);
+	return nbClasses;
+}
+
+
+/**
+ * Construit et renvoie un AFD reconnaissant le même langage que l'AFN spécifié (construction des sous-ensembles).
+ *
+ * L'alphabet de l'AFD est celui de l'AFN privé d'EPSILON ; la fonction de transition est totale,
+ * l'ensemble vide devenant un état puits s'il est accessible.
+ *
+ * Les symboles ayant les mêmes transitions depuis chaque état de l'AFN (p. ex. tous ceux qui n'apparaissent pas
+ * dans une expression régulière) forment une classe : les successeurs ne sont calculés qu'une fois par classe,
+ * et l'AFD n'a qu'une colonne par classe (voir `afd_compresser(AFD)`).
+ */
+AFD afn_determiniser(AFN A) {
+	setmap etats = setmap_new_empty();
+	AFD D = afn_determiniser_etats(A, &etats);
+	
+	setmap_free(&etats);
+	return D;
+}
+
+
+/**
+ * Comme `afn_determiniser(AFN)`, et écrit dans `etats` (une table vide) l'ensemble d'états de l'AFN
+ * correspondant à chaque état de l'AFD : l'état `d` de l'AFD est l'ensemble `etats->cles[d]`.
+ */
+AFD afn_determiniser_etats(AFN A, setmap *etats) {
+	check_param("etats", etats->len == 0);
+	
+	// alphabet de l'AFD : celui de l'AFN sans EPSILON
+	char *Sigma = checked_malloc(A->lenSigma);
+	int lenSigma = 0;
+	for(int i = 0; i < A->lenSigma; ++i) {
+		if(A->Sigma[i] != EPSILON) {
+			Sigma[lenSigma++] = A->Sigma[i];
+		}
+	}
+	Sigma[lenSigma] = '\0';
+	check_param("A->Sigma", lenSigma > 0);
+	
+	// indices des colonnes de l'AFN correspondant à chaque symbole de l'AFD
+	int *colonnes = checked_malloc(lenSigma * sizeof(int));
+	for(int j = 0; j < lenSigma; ++j) {
+		colonnes[j] = A->dico[Sigma[j] - ASCII_FIRST];
+	}
+	
+	// classes de symboles : les successeurs d'un état ne sont calculés que pour un symbole de chaque classe
+	int *classes = checked_malloc(lenSigma * sizeof(int));
+	int *representants = checked_malloc(lenSigma * sizeof(int));
+	const int nbClasses = afn_classes(A, colonnes, lenSigma, classes, representants);
+	
+	// chaque état de l'AFD est un ensemble d'états de l'AFN, interné dans `etats` ;
+	// l'identifiant d'un ensemble est le nom de l'état correspondant dans l'AFD
+	set R = set_copy_from(A->I, A->lenI);
+	afn_epsilon_closure_assign(A, &R);
+	setmap_intern(etats, &R, NULL);
+	
+	// `delta[d * nbClasses + c]` = δ(d, τ) pour tout symbole τ de la classe `c`, les lignes sont ajoutées au fur et à mesure
+	stack delta = stack_new_empty();
+	
+	int *vu = checked_malloc((A->Q + 1) * sizeof(int));
+	for(int q = 0; q <= A->Q; ++q) {
+		vu[q] = -1;
+	}
+	int marque = 0;
+	
+	// `etats->len` augmente tant que de nouveaux ensembles sont découverts
+	for(size_t d = 0; d < etats->len; ++d) {
+		for(int c = 0; c < nbClasses; ++c) {
+			set next = afn_successeurs(A, etats->cles[d], colonnes[representants[c]], vu, marque++);
+			afn_epsilon_closure_assign(A, &next);
+			
+			stack_push(&delta, setmap_intern(etats, &next, NULL));
+			set_free(&next);
+		}
+	}
+	
+	// un état de l'AFD est final s'il contient au moins un état final de l'AFN
+	set F_afn = set_copy_from(A->F, A->lenF);
+	stack F = stack_new_empty();
+	
+	for(size_t d = 0; d < etats->len; ++d) {
+		if(set_are_intersecting(etats->cles[d], F_afn)) {
+			stack_push(&F, (int) d);
+		}
+	}
+	
+	AFD D = afd_init_classes((int) etats->len - 1, 0, (int) F.len, F.buf, Sigma, classes, nbClasses);
+	for(int d = 0; d <= D->Q; ++d) {
+		memcpy(D->delta[d], &delta.buf[(size_t) d * nbClasses], nbClasses * sizeof(int));
+	}
+	
+	set_free(&F_afn);
+	stack_free(&F);
+	stack_free(&delta);
+	free(vu);
+	free(colonnes);
+	free(classes);
+	free(representants);
+	free(Sigma);
+	return D;
+}
+
+
+/**
+ * Construit et renvoie un AFN sans epsilon-transition reconnaissant le même langage que l'AFN spécifié.
+ *
+ * L'epsilon-fermeture E(p) de chaque état est calculée une seule fois ; on pose alors
+ * Δ'(p, τ) = ∪ Δ(r, τ) pour r ∈ E(p), et p est final si E(p) contient un état final.
+ * Seuls les états accessibles depuis les états initiaux sont conservés, puis renumérotés.
+ */
+AFN afn_supprimer_epsilon(AFN A) {
+	const int eps = A->dico[EPSILON - ASCII_FIRST];
+	
+	// epsilon-fermeture de chaque état, calculée une seule fois
+	set *fermetures = checked_malloc((A->Q + 1) * sizeof(set));
+	for(int q = 0; q <= A->Q; ++q) {
+		fermetures[q] = set_new_singleton(q);
+		afn_epsilon_closure_assign(A, &fermetures[q]);
+	}
+	
+	// `nom[q]` est le nouveau nom de l'état `q`, ou `-1` si `q` n'a pas (encore) été atteint ;
+	// `ordre` contient les états atteints dans l'ordre de leur découverte (parcours en largeur)
+	int *nom = checked_malloc((A->Q + 1) * sizeof(int));
+	int *vu = checked_malloc((A->Q + 1) * sizeof(int));
+	for(int q = 0; q <= A->Q; ++q) {
+		nom[q] = -1;
+		vu[q] = -1;
+	}
+	int marque = 0;
+	
+	stack ordre = stack_new_empty();
+	int *I = checked_malloc(A->lenI * sizeof(int));
+	
+	for(int i = 0; i < A->lenI; ++i) {
+		if(nom[A->I[i]] == -1) {
+			nom[A->I[i]] = (int) ordre.len;
+			stack_push(&ordre, A->I[i]);
+		}
+		
+		I[i] = nom[A->I[i]];
+	}
+	
+	// `succ[d * lenSigma + s]` = Δ'(d, s) (anciens noms) pour le `d`-ième état découvert
+	set *succ = checked_malloc((size_t) (A->Q + 1) * A->lenSigma * sizeof(set));
+	
+	for(size_t d = 0; d < ordre.len; ++d) {
+		set E = fermetures[ordre.buf[d]];
+		
+		for(int s = 0; s < A->lenSigma; ++s) {
+			set *S = &succ[d * A->lenSigma + s];
+			*S = (s == eps) ? set_new_empty() : afn_successeurs(A, E, s, vu, marque++);
+			
+			for(size_t j = 0; j < S->len; ++j) {
+				if(nom[S->buf[j]] == -1) {
+					nom[S->buf[j]] = (int) ordre.len;
+					stack_push(&ordre, S->buf[j]);
+				}
+			}
+		}
+	}
+	
+	// un état est final si son epsilon-fermeture contient un état final
+	set F_afn = set_copy_from(A->F, A->lenF);
+	stack F = stack_new_empty();
+	
+	for(size_t d = 0; d < ordre.len; ++d) {
+		if(set_are_intersecting(fermetures[ordre.buf[d]], F_afn)) {
+			stack_push(&F, (int) d);
+		}
+	}
+	
+	char *Sigma = checked_malloc(A->lenSigma + 1);
+	memcpy(Sigma, A->Sigma, A->lenSigma + 1);
+	
+	// SAFETY: `F.buf` est cédé à l'AFN, il vaut `NULL` si aucun état n'est final
+	AFN B = afn_init_owned((int) ordre.len - 1, I, A->lenI, F.buf, (int) F.len, Sigma, A->lenSigma);
+	B->sansEpsilon = 1;
+	
+	// chaque liste de transitions est allouée une seule fois, directement avec les nouveaux noms
+	for(size_t d = 0; d < ordre.len; ++d) {
+		for(int s = 0; s < A->lenSigma; ++s) {
+			set *S = &succ[d * A->lenSigma + s];
+			
+			if(S->len > 0) {
+				int *q2 = arena_alloc(&B->memoire, (S->len + 1) * sizeof(int));
+				for(size_t j = 0; j < S->len; ++j) {
+					q2[j] = nom[S->buf[j]];
+				}
+				q2[S->len] = INVALID_STATE;
+				
+				B->delta[d][s] = q2;
+			}
+			
+			set_free(S);
+		}
+	}
+	
+	for(int q = 0; q <= A->Q; ++q) {
+		set_free(&fermetures[q]);
+	}
+	
+	set_free(&F_afn);
+	stack_free(&ordre);
+	free(succ);
+	free(fermetures);
+	free(nom);
+	free(vu);
+	return B;
+}
+
+
 /**
  * Construit et renvoie un AFN acceptant le langage constitué du seul symbole `c`.
  */
@@ -365,6 +929,7 @@ AFN afn_char(char c, const char *Sigma) {
 	const int q1 = 1;
 	
 	AFN A = afn_init(Q, 1, &q0, 1, &q1, Sigma);
+	STATS_AJOUTER(etats, Q + 1);
 	afn_ajouter_transition(A, q0, c, q1);
 	
 	return A;
@@ -397,38 +962,29 @@ int* rshift_all_sized(const int *transitions, size_t len, size_t offset) {
 
 
 /**
- * Additionne un nombre à tous les éléments du tableau spécifié.
- *
- * Paramètres:
- * - transitions: un tableau de transitions terminé par `INVALID_STATE`.
- * - offset     : la valeur à ajouter à tous les éléments du tableau
- *
- * Renvoie: un nouveau tableau terminé par `INVALID_STATE` qu'il faudra désallouer avec `free()`.
+ * Modifie la fonction de transition de `B` pour prendre en compte toutes les transitions de `A` dont
+ * les états auront étés augmentés de `qA_offset` ; les listes recopiées sont prises dans l'arène de `B`.
  */
-int* rshift_all(const int *transitions, size_t offset) {
-	if(transitions == NULL) {
-		return NULL;
-	}
-	
-	size_t len = 0;
-	const int *ptr = transitions;
-	while(*ptr != INVALID_STATE) {
-		++len;
-		++ptr;
-	}
-	
-	return rshift_all_sized(transitions, len, offset);
-}
-
-
-/**
- * Modifie la fonction de transition `delta` pour prendre en compte toutes les transitions de `A` dont
- * les états auront étés augmentés de `qA_offset`.
- */
-void afn_delta_copy_assign(int ***delta, AFN A, int qA_offset) {
+void afn_delta_copy_assign(AFN B, AFN A, int qA_offset) {
 	for(int qA = 0; qA <= A->Q; ++qA) {
 		for(int s = 0; s < A->lenSigma; ++s) {
-			delta[qA + qA_offset][s] = rshift_all(A->delta[qA][s], qA_offset);
+			const int *transitions = A->delta[qA][s];
+			if(transitions == NULL) {
+				continue;
+			}
+			
+			size_t len = 0;
+			while(transitions[len] != INVALID_STATE) {
+				++len;
+			}
+			
+			int *out = arena_alloc(&B->memoire, (len + 1) * sizeof(int));
+			for(size_t i = 0; i < len; ++i) {
+				out[i] = transitions[i] + qA_offset;
+			}
+			
+			out[len] = INVALID_STATE;
+			B->delta[qA + qA_offset][s] = out;
 		}
 	}
 }
@@ -446,33 +1002,100 @@ AFN afn_union(AFN A, AFN B) {
 	const char *Sigma = A->Sigma;
 	
 	AFN U = afn_init(Q, 1, &q0, 1, &qQ, Sigma);
+	STATS_AJOUTER(etats, Q + 1);
 	
 	// Décalage des états de `A` et `B` dans l'union `U`
 	const int qA_offset = 1;
 	const int qB_offset = A->Q + 2;
 	
 	// Copie des transitions présentes dans `A` et `B`
-	afn_delta_copy_assign(U->delta, A, qA_offset);
-	afn_delta_copy_assign(U->delta, B, qB_offset);
+	afn_delta_copy_assign(U, A, qA_offset);
+	afn_delta_copy_assign(U, B, qB_offset);
+	
+	tbuf T = tbuf_new_empty();
 	
 	// Ajout des ε-transitions de l'état initial `q0` de `U` vers les états initiaux de `A` et `B`
 	for(int i = 0; i < A->lenI; ++i) {
-		afn_ajouter_transition(U, q0, EPSILON, A->I[i] + qA_offset);
+		tbuf_push(&T, q0, EPSILON, A->I[i] + qA_offset);
 	}
 	
 	for(int i = 0; i < B->lenI; ++i) {
-		afn_ajouter_transition(U, q0, EPSILON, B->I[i] + qB_offset);
+		tbuf_push(&T, q0, EPSILON, B->I[i] + qB_offset);
 	}
 	
 	// Ajout des ε-transitions des états finaux de `A` et `B` vers l'état final `qQ` de `U`
 	for(int i = 0; i < A->lenF; ++i) {
-		afn_ajouter_transition(U, A->F[i] + qA_offset, EPSILON, qQ);
+		tbuf_push(&T, A->F[i] + qA_offset, EPSILON, qQ);
 	}
 	
 	for(int i = 0; i < B->lenF; ++i) {
-		afn_ajouter_transition(U, B->F[i] + qB_offset, EPSILON, qQ);
+		tbuf_push(&T, B->F[i] + qB_offset, EPSILON, qQ);
+	}
+	
+	afn_ajouter_transitions(U, &T);
+	tbuf_free(&T);
+	
+	return U;
+}
+
+
+/**
+ * Construit et renvoie l'union de `n` AFN, sans fusionner leurs états finaux : un nouvel état initial `0`
+ * mène par epsilon-transitions aux états initiaux de chaque AFN, et les états finaux de chaque AFN restent
+ * finaux, si bien que l'on peut retrouver de quel AFN provient chaque état final.
+ *
+ * Les états de `automates[i]` sont décalés de `decalages[i]` dans l'union (`decalages` peut valoir `NULL`).
+ */
+AFN afn_union_multiple(AFN *automates, int n, int *decalages) {
+	check_param("n", n > 0);
+	
+	const char *Sigma = automates[0]->Sigma;
+	
+	// chaque AFN est recopié à la suite du précédent, l'état `0` étant le nouvel état initial
+	int Q = 0;
+	int lenF = 0;
+	
+	for(int i = 0; i < n; ++i) {
+		check_param("automates[i]->Sigma equals automates[0]->Sigma", strcmp(automates[i]->Sigma, Sigma) == 0);
+		
+		Q += automates[i]->Q + 1;
+		lenF += automates[i]->lenF;
+	}
+	
+	int *F = checked_malloc((lenF > 0 ? lenF : 1) * sizeof(int));
+	lenF = 0;
+	
+	for(int i = 0, offset = 1; i < n; offset += automates[i]->Q + 1, ++i) {
+		for(int j = 0; j < automates[i]->lenF; ++j) {
+			F[lenF++] = automates[i]->F[j] + offset;
+		}
+	}
+	
+	const int q0 = 0;
+	AFN U = afn_init(Q, 1, &q0, lenF, F, Sigma);
+	STATS_AJOUTER(etats, Q + 1);
+	free(F);
+	
+	tbuf T = tbuf_new_empty();
+	
+	for(int i = 0, offset = 1; i < n; offset += automates[i]->Q + 1, ++i) {
+		AFN A = automates[i];
+		
+		if(decalages != NULL) {
+			decalages[i] = offset;
+		}
+		
+		// Copie des transitions de `A`, puis ε-transitions depuis `q0` vers ses états initiaux
+		afn_delta_copy_assign(U, A, offset);
+		
+		for(int j = 0; j < A->lenI; ++j) {
+			tbuf_push(&T, q0, EPSILON, A->I[j] + offset);
+		}
 	}
 	
+	afn_ajouter_transitions(U, &T);
+	tbuf_free(&T);
+	
 	return U;
 }
 
@@ -495,18 +1118,24 @@ AFN afn_concat(AFN A, AFN B) {
 	
 	AFN C = afn_init(Q, A->lenI, A->I, B->lenF, F, Sigma);  // `rshift_all_sized()` rajoute un élément `INVALID_STATE` à la fin,
 	free(F);                                                // mais `afn_init` ne copiera que `lenF` éléments, donc aucun soucis d'accumulation
+	STATS_AJOUTER(etats, Q + 1);
 	
 	// Copie des transitions présentes dans `A` et `B`
-	afn_delta_copy_assign(C->delta, A, qA_offset);
-	afn_delta_copy_assign(C->delta, B, qB_offset);
+	afn_delta_copy_assign(C, A, qA_offset);
+	afn_delta_copy_assign(C, B, qB_offset);
 	
 	// Ajout des ε-transitions depuis les états finaux de `A` vers les états initiaux de `B`
+	tbuf T = tbuf_new_empty();
+	
 	for(int i = 0; i < A->lenF; ++i) {
 		for(int j = 0; j < B->lenI; ++j) {
-			afn_ajouter_transition(C, A->F[i] + qA_offset, EPSILON, B->I[j] + qB_offset);
+			tbuf_push(&T, A->F[i] + qA_offset, EPSILON, B->I[j] + qB_offset);
 		}
 	}
 	
+	afn_ajouter_transitions(C, &T);
+	tbuf_free(&T);
+	
 	return C;
 }
 
@@ -520,38 +1149,124 @@ AFN afn_kleene(AFN A) {
 	const int qQ = Q;
 	
 	AFN K = afn_init(Q, 1, &q0, 1, &qQ, A->Sigma);
+	STATS_AJOUTER(etats, Q + 1);
 	
 	// Décalage des états de `A` dans `K`
 	const int qA_offset = 1;
 	
 	// Copie des transitions de `A`
-	afn_delta_copy_assign(K->delta, A, qA_offset);
+	afn_delta_copy_assign(K, A, qA_offset);
+	
+	tbuf T = tbuf_new_empty();
 	
 	// Ajout des ε-transitions depuis `q0` vers les états initiaux de `A`
 	for(int i = 0; i < A->lenI; ++i) {
-		afn_ajouter_transition(K, q0, EPSILON, A->I[i] + qA_offset);
+		tbuf_push(&T, q0, EPSILON, A->I[i] + qA_offset);
 	}
 	
 	// Ajout des ε-transitions depuis les états finaux de `A` vers `qQ`
 	for(int i = 0; i < A->lenF; ++i) {
-		afn_ajouter_transition(K, A->F[i] + qA_offset, EPSILON, qQ);
+		tbuf_push(&T, A->F[i] + qA_offset, EPSILON, qQ);
 	}
 	
 	// Ajout des ε-transitions depuis les états finaux de `A` vers ses états initiaux
 	// (répétabilité)
 	for(int i = 0; i < A->lenF; ++i) {
 		for(int j = 0; j < A->lenI; ++j) {
-			afn_ajouter_transition(K, A->F[i] + qA_offset, EPSILON, A->I[j] + qA_offset);
+			tbuf_push(&T, A->F[i] + qA_offset, EPSILON, A->I[j] + qA_offset);
 		}
 	}
 	
 	// Ajout de l'ε-transition depuis `q0` vers `qQ` (optionnalité)
-	afn_ajouter_transition(K, q0, EPSILON, qQ);
+	tbuf_push(&T, q0, EPSILON, qQ);
+	
+	afn_ajouter_transitions(K, &T);
+	tbuf_free(&T);
 	
 	return K;
 }
 
 
+/**
+ * Construit et renvoie un AFN reconnaissant Σ*L, où L est le langage de l'AFN spécifié : un nouvel état
+ * initial boucle sur tous les symboles de l'alphabet et mène par epsilon-transitions aux états initiaux de `A`.
+ *
+ * Un mot appartient au langage obtenu si et seulement si l'un de ses suffixes appartient à L ;
+ * le simuler revient donc à rechercher L n'importe où dans un texte.
+ */
+AFN afn_prefixer(AFN A) {
+	const int Q = A->Q + 1;
+	const int q0 = Q;
+	
+	char *Sigma = checked_malloc(A->lenSigma + 1);
+	memcpy(Sigma, A->Sigma, A->lenSigma + 1);
+	
+	int *I = checked_malloc(sizeof(int));
+	I[0] = q0;
+	
+	int *F = NULL;
+	if(A->lenF > 0) {
+		F = checked_malloc(A->lenF * sizeof(int));
+		memcpy(F, A->F, A->lenF * sizeof(int));
+	}
+	
+	AFN P = afn_init_owned(Q, I, 1, F, A->lenF, Sigma, A->lenSigma);
+	
+	// Copie des transitions de `A`, sans décalage
+	afn_delta_copy_assign(P, A, 0);
+	
+	tbuf T = tbuf_new_empty();
+	
+	// Boucle de `q0` sur tous les symboles, puis ε-transitions vers les états initiaux de `A`
+	for(int s = 0; s < A->lenSigma; ++s) {
+		if(A->Sigma[s] != EPSILON) {
+			tbuf_push(&T, q0, A->Sigma[s], q0);
+		}
+	}
+	
+	for(int i = 0; i < A->lenI; ++i) {
+		tbuf_push(&T, q0, EPSILON, A->I[i]);
+	}
+	
+	afn_ajouter_transitions(P, &T);
+	tbuf_free(&T);
+	
+	return P;
+}
+
+
+/**
+ * Construit et renvoie l'AFN miroir de l'AFN spécifié, qui reconnaît les mots de L lus de droite à gauche :
+ * toutes les transitions sont inversées, et les états initiaux et finaux échangés.
+ */
+AFN afn_inverser(AFN A) {
+	check_param("A->lenF", A->lenF > 0);
+	
+	AFN R = afn_init(A->Q, A->lenF, A->F, A->lenI, A->I, A->Sigma);
+	
+	tbuf T = tbuf_new_empty();
+	
+	for(int q = 0; q <= A->Q; ++q) {
+		for(int s = 0; s < A->lenSigma; ++s) {
+			const int *q2 = afn_transitions(A, q, s);
+			if(q2 == NULL) {
+				continue;
+			}
+			
+			while(*q2 != INVALID_STATE) {
+				tbuf_push(&T, *q2, A->Sigma[s], q);
+				++q2;
+			}
+		}
+	}
+	
+	afn_ajouter_transitions(R, &T);
+	tbuf_free(&T);
+	
+	return R;
+}
+
+
 /**
  * Affiche l'AFN spécifié dans le flux de sortie standard.
  */
@@ -698,23 +1413,56 @@ void afn_dot(AFN A, const char *path) {
 }
 
 
+/**
+ * Renvoie une estimation du nombre d'octets occupés en mémoire par l'AFN spécifié (fonction de transition,
+ * forme figée et fichier projeté compris).
+ */
+size_t afn_taille(AFN A) {
+	size_t taille = sizeof(struct AFN);
+	
+	if(A->projection != NULL) {
+		return taille + sizeof(struct CSR) + A->lenProjection;
+	}
+	
+	taille += (A->lenI + A->lenF) * sizeof(int) + A->lenSigma + 1;
+	taille += arena_taille(&A->memoire);
+	
+	if(A->csr != NULL) {
+		taille += sizeof(struct CSR);
+		taille += (A->Q + 2 + 2 * (A->csr->nbPaires + 1) + A->csr->lenDest + 1) * sizeof(int);
+	}
+	
+	return taille;
+}
+
+
 /**
  * Libère les ressources allouées à un AFN.
  */
 void afn_free(AFN A) {
+	if(A->projection != NULL) {
+		// les tableaux de l'AFN sont ceux du fichier projeté
+		munmap(A->projection, A->lenProjection);
+		free(A->csr);
+		free(A);
+		return;
+	}
+	
 	free(A->I);
 	free(A->F);
 	free(A->Sigma);
 	
-	for(int q = 0; q <= A->Q; ++q) {
-		for(int s = 0; s < A->lenSigma; ++s) {
-			free(A->delta[q][s]);
-		}
-		
-		free(A->delta[q]);
+	// `delta`, ses lignes et ses listes sont libérés en une fois avec l'arène
+	arena_free(&A->memoire);
+	
+	if(A->csr != NULL) {
+		free(A->csr->ligne);
+		free(A->csr->symbole);
+		free(A->csr->debut);
+		free(A->csr->dest);
+		free(A->csr);
 	}
 	
-	free(A->delta);
 	free(A);
 	A = NULL;
 }
@@ -2,8 +2,12 @@
 #define AFN_H
 
 #include "af.h"
+#include "afd.h"
 
+#include "util/arena.h"
 #include "util/set.h"
+#include "util/setmap.h"
+#include "util/tbuf.h"
 
 /**
  * Le symbole représentant une possible epsilon-transition dans un AFN.
@@ -13,6 +17,48 @@
 #define EPSILON '&'
 
 
+/**
+ * Représente la forme figée d'une fonction de transition d'AFN, rangée au format CSR (compressed sparse row).
+ *
+ * Les transitions de l'état `q` sont décrites par les paires d'indices `ligne[q]` ... `ligne[q + 1] - 1` ;
+ * la paire `p` associe le symbole d'indice `symbole[p]` (trié par ordre croissant au sein d'une ligne) aux états
+ * `dest[debut[p]]`, `dest[debut[p] + 1]`, ..., la liste étant terminée par `INVALID_STATE`.
+ *
+ * Toutes les transitions sont donc stockées dans quatre tableaux contigus, dans l'ordre croissant des états.
+ */
+struct CSR {
+	/**
+	 * L'indice de la première paire de chaque état ; `Q + 2` éléments.
+	 */
+	int *ligne;
+	
+	/**
+	 * L'indice dans `Sigma` du symbole de chaque paire.
+	 */
+	int *symbole;
+	
+	/**
+	 * L'indice dans `dest` de la liste des états d'arrivée de chaque paire.
+	 */
+	int *debut;
+	
+	/**
+	 * Les listes des états d'arrivée, chacune terminée par `INVALID_STATE`.
+	 */
+	int *dest;
+	
+	/**
+	 * Le nombre de paires (état, symbole) possédant au moins une transition.
+	 */
+	int nbPaires;
+	
+	/**
+	 * La taille du tableau `dest` (marqueurs `INVALID_STATE` compris).
+	 */
+	int lenDest;
+};
+
+
 /**
  * Représente un automate fini non-déterministe (AFN).
  */
@@ -66,6 +112,39 @@ struct AFN {
 	 */
 	int ***delta;
 	
+	/**
+	 * L'arène dont proviennent `delta`, ses lignes et toutes ses listes : elles sont libérées ensemble par
+	 * `afn_free(AFN)`, et une liste remplacée par une plus longue n'est pas libérée avant.
+	 */
+	arena memoire;
+	
+	/**
+	 * La forme figée de `delta`, ou `NULL` si l'AFN n'a pas encore été figé.
+	 *
+	 * Voir aussi:
+	 * - `afn_figer(AFN)`
+	 */
+	struct CSR *csr;
+	
+	/**
+	 * Vaut `1` si l'automate ne possède aucune epsilon-transition, auquel cas les epsilon-fermetures
+	 * ne sont jamais calculées ; vaut `0` si l'automate peut en posséder.
+	 *
+	 * Voir aussi:
+	 * - `afn_supprimer_epsilon(AFN)`
+	 */
+	int sansEpsilon;
+	
+	/**
+	 * La projection en mémoire du fichier dont proviennent `I`, `F`, `Sigma` et `csr`, ou `NULL` s'ils ont été
+	 * alloués ; `lenProjection` est sa taille en octets. Un AFN projeté est figé et n'a pas de `delta`.
+	 *
+	 * Voir aussi:
+	 * - `binaire_charger_afn(const char*, int)`
+	 */
+	void *projection;
+	size_t lenProjection;
+	
 	/**
 	 * Ce tableau permet de récupérer l'indice du symbole τ dans l'alphabet Σ.
 	 *
@@ -102,10 +181,30 @@ AFN afn_init(int Q, int nbInitiaux, const int *listInitiaux, int nbFinals, const
 
 /**
  * Modifie la fonction de transition de l'AFN spécifié de façon à ce que Δ(q1, s) contienne l'état q2.
+ *
+ * Remarque:
+ * - La liste Δ(q1, s) est réallouée dans l'arène de l'AFN à chaque appel, l'ancienne n'étant libérée que par
+ *   `afn_free(AFN)` ; pour ajouter de nombreuses transitions, préférer `afn_ajouter_transitions(AFN, tbuf*)`.
  */
 void afn_ajouter_transition(AFN A, int q1, char s, int q2);
 
 
+/**
+ * Ajoute à l'AFN spécifié toutes les transitions du tampon `T`, puis vide ce tampon.
+ *
+ * Les transitions sont regroupées par paire (q, τ) et dédoublonnées, si bien que chaque liste Δ(q, τ) modifiée
+ * n'est allouée qu'une seule fois, fusionnée avec les transitions déjà présentes dans l'AFN.
+ */
+void afn_ajouter_transitions(AFN A, tbuf *T);
+
+
+/**
+ * Fige l'AFN spécifié : sa fonction de transition est recopiée au format CSR, que les fonctions de simulation
+ * parcourent ensuite séquentiellement. Un AFN figé ne peut plus recevoir de nouvelles transitions.
+ */
+void afn_figer(AFN A);
+
+
 /**
  * Initialise et renvoie un nouvel AFN à partir d'un fichier `filename` écrit au format :
  * ```
@@ -124,18 +223,65 @@ void afn_ajouter_transition(AFN A, int q1, char s, int q2);
 AFN afn_finit(const char *filename);
 
 
+/**
+ * Calcul l'epsilon-fermeture d'un ensemble d'états `G` passé en paramètre; écrit ce résultat dans cedit paramètre.
+ */
+void afn_epsilon_closure_assign(AFN A, set *G);
+
+
 /**
  * Calcul et renvoie l'epsilon-fermeture d'un ensemble d'états `R` trié par ordre croissant et dont le dernier élément `INVALID_STATE`.
  */
 int* afn_epsilon_fermeture(AFN A, const int *R);
 
 
+/**
+ * Calcul l'ensemble des états accessibles depuis `R` en lisant le symbole d'indice `s` dans `Sigma`,
+ * sans epsilon-fermeture.
+ *
+ * Paramètres:
+ * - vu    : un tableau de `Q + 1` marqueurs, tous différents de `marque` à l'appel
+ * - marque: la valeur utilisée pour marquer les états déjà ajoutés
+ */
+set afn_successeurs(AFN A, set R, int s, int *vu, int marque);
+
+
 /**
  * Renvoie `1` si la chaîne spécifiée est acceptée par l'AFN spécifié, sinon renvoie `0`.
  */
 int afn_simuler(AFN A, const char *s);
 
 
+/**
+ * Construit et renvoie un AFD reconnaissant le même langage que l'AFN spécifié (construction des sous-ensembles).
+ *
+ * L'alphabet de l'AFD est celui de l'AFN privé d'EPSILON ; la fonction de transition est totale,
+ * l'ensemble vide devenant un état puits s'il est accessible.
+ *
+ * Les symboles ayant les mêmes transitions depuis chaque état de l'AFN (p. ex. tous ceux qui n'apparaissent pas
+ * dans une expression régulière) forment une classe : les successeurs ne sont calculés qu'une fois par classe,
+ * et l'AFD n'a qu'une colonne par classe (voir `afd_compresser(AFD)`).
+ */
+AFD afn_determiniser(AFN A);
+
+
+/**
+ * Comme `afn_determiniser(AFN)`, et écrit dans `etats` (une table vide) l'ensemble d'états de l'AFN
+ * correspondant à chaque état de l'AFD : l'état `d` de l'AFD est l'ensemble `etats->cles[d]`.
+ */
+AFD afn_determiniser_etats(AFN A, setmap *etats);
+
+
+/**
+ * Construit et renvoie un AFN sans epsilon-transition reconnaissant le même langage que l'AFN spécifié.
+ *
+ * L'epsilon-fermeture E(p) de chaque état est calculée une seule fois ; on pose alors
+ * Δ'(p, τ) = ∪ Δ(r, τ) pour r ∈ E(p), et p est final si E(p) contient un état final.
+ * Seuls les états accessibles depuis les états initiaux sont conservés, puis renumérotés.
+ */
+AFN afn_supprimer_epsilon(AFN A);
+
+
 /**
  * Construit et renvoie un AFN acceptant le langage constitué du seul symbole `c`.
  */
@@ -148,6 +294,16 @@ AFN afn_char(char c, const char *Sigma);
 AFN afn_union(AFN A, AFN B);
 
 
+/**
+ * Construit et renvoie l'union de `n` AFN, sans fusionner leurs états finaux : un nouvel état initial `0`
+ * mène par epsilon-transitions aux états initiaux de chaque AFN, et les états finaux de chaque AFN restent
+ * finaux, si bien que l'on peut retrouver de quel AFN provient chaque état final.
+ *
+ * Les états de `automates[i]` sont décalés de `decalages[i]` dans l'union (`decalages` peut valoir `NULL`).
+ */
+AFN afn_union_multiple(AFN *automates, int n, int *decalages);
+
+
 /**
  * Construit et renvoie la concaténation de deux AFN.
  */
@@ -160,6 +316,23 @@ AFN afn_concat(AFN A, AFN B);
 AFN afn_kleene(AFN A);
 
 
+/**
+ * Construit et renvoie un AFN reconnaissant Σ*L, où L est le langage de l'AFN spécifié : un nouvel état
+ * initial boucle sur tous les symboles de l'alphabet et mène par epsilon-transitions aux états initiaux de `A`.
+ *
+ * Un mot appartient au langage obtenu si et seulement si l'un de ses suffixes appartient à L ;
+ * le simuler revient donc à rechercher L n'importe où dans un texte.
+ */
+AFN afn_prefixer(AFN A);
+
+
+/**
+ * Construit et renvoie l'AFN miroir de l'AFN spécifié, qui reconnaît les mots de L lus de droite à gauche :
+ * toutes les transitions sont inversées, et les états initiaux et finaux échangés.
+ */
+AFN afn_inverser(AFN A);
+
+
 /**
  * Affiche l'AFN spécifié dans le flux de sortie standard.
  */
@@ -172,6 +345,13 @@ void afn_print(AFN A);
 void afn_dot(AFN A, const char *filename);
 
 
+/**
+ * Renvoie une estimation du nombre d'octets occupés en mémoire par l'AFN spécifié (fonction de transition,
+ * forme figée et fichier projeté compris).
+ */
+size_t afn_taille(AFN A);
+
+
 /**
  * Libère les ressources allouées à un AFN.
  */
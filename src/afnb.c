@@ -0,0 +1,186 @@
+#include "afnb.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "util/misc.h"
+
+/**
+ * Ajoute l'état `q` à l'ensemble de bits `B`.
+ */
+#define BIT_SET(B, q) ((B)[(q) / 64] |= (uint64_t) 1 << ((q) % 64))
+
+/**
+ * Alloue et renvoie un tableau de `n` ensembles de bits vides de `mots` mots chacun.
+ */
+static uint64_t* bits_new(size_t n, size_t mots) {
+	uint64_t *B = checked_malloc(n * mots * sizeof(uint64_t));
+	memset(B, 0, n * mots * sizeof(uint64_t));
+	
+	return B;
+}
+
+
+/**
+ * Compile l'AFN spécifié pour une simulation par ensembles de bits ; l'AFN peut être libéré ensuite.
+ *
+ * Remarque:
+ * - L'espace mémoire occupé est proportionnel au nombre de paires (état, symbole) multiplié par `Q / 8` octets.
+ */
+AFNB afnb_compiler(AFN A) {
+	const size_t mots = (A->Q + 1 + 63) / 64;
+	const int eps = A->dico[EPSILON - ASCII_FIRST];
+	
+	AFNB B = checked_malloc(sizeof(struct AFNB));
+	B->Q = A->Q;
+	B->mots = mots;
+	B->lenSigma = A->lenSigma;
+	memcpy(B->dico, A->dico, sizeof(B->dico));
+	
+	// epsilon-fermeture de chaque état, calculée une seule fois
+	uint64_t *fermetures = bits_new(A->Q + 1, mots);
+	for(int q = 0; q <= A->Q; ++q) {
+		set E = set_new_singleton(q);
+		afn_epsilon_closure_assign(A, &E);
+		
+		for(size_t i = 0; i < E.len; ++i) {
+			BIT_SET(&fermetures[q * mots], E.buf[i]);
+		}
+		
+		set_free(&E);
+	}
+	
+	// états initiaux et finaux
+	B->initial = bits_new(1, mots);
+	for(int i = 0; i < A->lenI; ++i) {
+		for(size_t w = 0; w < mots; ++w) {
+			B->initial[w] |= fermetures[A->I[i] * mots + w];
+		}
+	}
+	
+	B->finals = bits_new(1, mots);
+	for(int i = 0; i < A->lenF; ++i) {
+		BIT_SET(B->finals, A->F[i]);
+	}
+	
+	// dénombrement des paires (état, symbole), EPSILON exclu
+	B->paire = checked_malloc((size_t) (A->Q + 1) * A->lenSigma * sizeof(int));
+	B->nbPaires = 0;
+	
+	for(int q = 0; q <= A->Q; ++q) {
+		for(int s = 0; s < A->lenSigma; ++s) {
+			int *q2 = A->delta[q][s];
+			int existe = s != eps && q2 != NULL && *q2 != INVALID_STATE;
+			
+			B->paire[q * A->lenSigma + s] = existe ? B->nbPaires++ : -1;
+		}
+	}
+	
+	// successeurs de chaque paire, epsilon-fermeture comprise
+	B->actifs = bits_new(A->lenSigma, mots);
+	B->succ = bits_new(B->nbPaires > 0 ? B->nbPaires : 1, mots);
+	
+	for(int q = 0; q <= A->Q; ++q) {
+		for(int s = 0; s < A->lenSigma; ++s) {
+			int p = B->paire[q * A->lenSigma + s];
+			if(p == -1) {
+				continue;
+			}
+			
+			BIT_SET(&B->actifs[s * mots], q);
+			
+			uint64_t *S = &B->succ[p * mots];
+			for(int *q2 = A->delta[q][s]; *q2 != INVALID_STATE; ++q2) {
+				for(size_t w = 0; w < mots; ++w) {
+					S[w] |= fermetures[*q2 * mots + w];
+				}
+			}
+		}
+	}
+	
+	free(fermetures);
+	return B;
+}
+
+
+/**
+ * Renvoie `1` si la chaîne spécifiée est acceptée par l'AFNB spécifié, sinon renvoie `0`.
+ */
+int afnb_simuler(AFNB B, const char *s) {
+	const size_t mots = B->mots;
+	
+	// `R` et `R_next` se partagent une seule allocation et sont échangés après chaque caractère
+	uint64_t *buf = checked_malloc(2 * mots * sizeof(uint64_t));
+	uint64_t *R = buf;
+	uint64_t *R_next = buf + mots;
+	memcpy(R, B->initial, mots * sizeof(uint64_t));
+	
+	char c;
+	for(size_t i = 0; (c = s[i]) != '\0'; ++i) {
+		int col = (c < ASCII_FIRST || c > ASCII_LAST || c == EPSILON) ? -1 : B->dico[c - ASCII_FIRST];
+		if(col == -1) {
+			free(buf);
+			return 0;
+		}
+		
+		memset(R_next, 0, mots * sizeof(uint64_t));
+		
+		const uint64_t *actifs = &B->actifs[col * mots];
+		const int *paire = &B->paire[col];
+		
+		// seuls les états de `R` ayant une transition par `c` contribuent à `R_next`
+		uint64_t vivant = 0;
+		for(size_t w = 0; w < mots; ++w) {
+			uint64_t m = R[w] & actifs[w];
+			
+			while(m != 0) {
+				int q = (int) (w * 64) + __builtin_ctzll(m);
+				m &= m - 1;
+				
+				const uint64_t *S = &B->succ[(size_t) paire[q * B->lenSigma] * mots];
+				for(size_t v = 0; v < mots; ++v) {
+					R_next[v] |= S[v];
+				}
+			}
+		}
+		
+		for(size_t w = 0; w < mots; ++w) {
+			vivant |= R_next[w];
+		}
+		
+		uint64_t *tmp = R;
+		R = R_next;
+		R_next = tmp;
+		
+		if(vivant == 0) {
+			// plus aucun état actif : aucune suite ne peut être acceptée
+			free(buf);
+			return 0;
+		}
+	}
+	
+	int accepted = 0;
+	for(size_t w = 0; w < mots; ++w) {
+		if((R[w] & B->finals[w]) != 0) {
+			accepted = 1;
+			break;
+		}
+	}
+	
+	free(buf);
+	return accepted;
+}
+
+
+/**
+ * Libère les ressources allouées à un AFNB.
+ */
+void afnb_free(AFNB B) {
+	free(B->initial);
+	free(B->finals);
+	free(B->actifs);
+	free(B->paire);
+	free(B->succ);
+	free(B);
+}
@@ -0,0 +1,92 @@
+#ifndef AFNB_H
+#define AFNB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "afn.h"
+
+/**
+ * Représente un AFN compilé pour une simulation par ensembles de bits (AFNB).
+ *
+ * Un ensemble d'états est un tableau de `mots` entiers de 64 bits, l'état `q` correspondant au bit
+ * `q % 64` du mot `q / 64`. Les successeurs de chaque état par chaque symbole sont précalculés sous cette
+ * forme, epsilon-fermeture comprise, si bien qu'une étape de simulation se réduit à des OU bit à bit.
+ */
+struct AFNB {
+	/**
+	 * Le plus grand état de l'AFN.
+	 */
+	int Q;
+	
+	/**
+	 * Le nombre de mots de 64 bits d'un ensemble d'états, c.-à-d. `ceil((Q + 1) / 64)`.
+	 */
+	size_t mots;
+	
+	/**
+	 * La taille de l'alphabet de l'AFN (EPSILON compris).
+	 */
+	int lenSigma;
+	
+	/**
+	 * Une copie du dictionnaire de l'AFN.
+	 */
+	int dico[MAX_SYMBOLES];
+	
+	/**
+	 * L'epsilon-fermeture des états initiaux.
+	 */
+	uint64_t *initial;
+	
+	/**
+	 * Les états finaux.
+	 */
+	uint64_t *finals;
+	
+	/**
+	 * `actifs[s * mots]` ... : les états possédant au moins une transition par le symbole d'indice `s`.
+	 */
+	uint64_t *actifs;
+	
+	/**
+	 * `paire[q * lenSigma + s]` est l'indice dans `succ` des successeurs de `q` par le symbole d'indice `s`,
+	 * ou `-1` si `q` n'a aucune transition par ce symbole.
+	 */
+	int *paire;
+	
+	/**
+	 * `succ[p * mots]` ... : l'epsilon-fermeture des successeurs de la paire d'indice `p`.
+	 */
+	uint64_t *succ;
+	
+	/**
+	 * Le nombre de paires (état, symbole) possédant au moins une transition.
+	 */
+	int nbPaires;
+};
+
+typedef struct AFNB* AFNB;
+
+
+/**
+ * Compile l'AFN spécifié pour une simulation par ensembles de bits ; l'AFN peut être libéré ensuite.
+ *
+ * Remarque:
+ * - L'espace mémoire occupé est proportionnel au nombre de paires (état, symbole) multiplié par `Q / 8` octets.
+ */
+AFNB afnb_compiler(AFN A);
+
+
+/**
+ * Renvoie `1` si la chaîne spécifiée est acceptée par l'AFNB spécifié, sinon renvoie `0`.
+ */
+int afnb_simuler(AFNB B, const char *s);
+
+
+/**
+ * Libère les ressources allouées à un AFNB.
+ */
+void afnb_free(AFNB B);
+
+#endif // AFNB_H
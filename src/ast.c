@@ -0,0 +1,555 @@
+#include "ast.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "util/misc.h"
+
+/**
+ * Alloue et renvoie un nouveau nœud sans fils.
+ */
+static Ast ast_noeud(TypeAst type, char c) {
+	Ast A = checked_malloc(sizeof(struct Ast));
+	A->type = type;
+	A->c = c;
+	A->fils = NULL;
+	A->nbFils = 0;
+	A->capacity = 0;
+	A->empreinte = 0;
+	
+	return A;
+}
+
+
+/**
+ * Ajoute un fils à la fin des fils du nœud spécifié.
+ */
+static void ast_ajouter(Ast A, Ast fils) {
+	if(A->nbFils == A->capacity) {
+		A->capacity = (A->capacity == 0) ? 2 : (A->capacity * 2);
+		A->fils = checked_realloc(A->fils, A->capacity * sizeof(Ast));
+	}
+	
+	A->fils[A->nbFils++] = fils;
+}
+
+
+/**
+ * Ajoute `fils` aux fils de `A` ; si `fils` est du même type que `A` (union ou concaténation), ce sont
+ * ses fils qui sont ajoutés, et le nœud `fils` est libéré.
+ */
+static void ast_ajouter_aplati(Ast A, Ast fils) {
+	if(fils->type != A->type) {
+		ast_ajouter(A, fils);
+		return;
+	}
+	
+	for(int i = 0; i < fils->nbFils; ++i) {
+		ast_ajouter(A, fils->fils[i]);
+	}
+	
+	free(fils->fils);
+	free(fils);
+}
+
+
+/**
+ * Libère un nœud sans libérer ses fils.
+ */
+static void ast_free_noeud(Ast A) {
+	free(A->fils);
+	free(A);
+}
+
+
+/**
+ * Calcule l'empreinte du nœud spécifié à partir de celles de ses fils (FNV-1a).
+ */
+static void ast_calculer_empreinte(Ast A) {
+	size_t h = (size_t) 14695981039346656037ULL;
+	h = (h ^ (size_t) A->type) * (size_t) 1099511628211ULL;
+	h = (h ^ (size_t) (unsigned char) A->c) * (size_t) 1099511628211ULL;
+	
+	for(int i = 0; i < A->nbFils; ++i) {
+		h = (h ^ A->fils[i]->empreinte) * (size_t) 1099511628211ULL;
+	}
+	
+	A->empreinte = h;
+}
+
+
+/**
+ * Renvoie `1` si les deux arbres spécifiés, dont les empreintes sont calculées, sont identiques, sinon renvoie `0`.
+ */
+static int ast_egal(Ast A, Ast B) {
+	if(A == B) {
+		return 1;
+	}
+	
+	if(A->empreinte != B->empreinte || A->type != B->type || A->c != B->c || A->nbFils != B->nbFils) {
+		return 0;
+	}
+	
+	for(int i = 0; i < A->nbFils; ++i) {
+		if(!ast_egal(A->fils[i], B->fils[i])) {
+			return 0;
+		}
+	}
+	
+	return 1;
+}
+
+
+/**
+ * Regroupe les arbres identiques parmi les `n` arbres de `arbres` (dont les empreintes sont calculées) :
+ * `representant[i]` reçoit l'indice du premier arbre identique à `arbres[i]`, ou `-1` si `arbres[i]` vaut `NULL`.
+ */
+static void ast_regrouper(Ast *arbres, int n, int *representant) {
+	size_t tableCapacity = 16;
+	while(tableCapacity < 2 * (size_t) n) {
+		tableCapacity *= 2;
+	}
+	
+	int *table = checked_malloc(tableCapacity * sizeof(int));
+	memset(table, -1, tableCapacity * sizeof(int));
+	
+	const size_t mask = tableCapacity - 1;
+	for(int i = 0; i < n; ++i) {
+		representant[i] = -1;
+		if(arbres[i] == NULL) {
+			continue;
+		}
+		
+		size_t k = arbres[i]->empreinte & mask;
+		while(table[k] != -1 && !ast_egal(arbres[table[k]], arbres[i])) {
+			k = (k + 1) & mask;
+		}
+		
+		if(table[k] == -1) {
+			table[k] = i;
+		}
+		
+		representant[i] = table[k];
+	}
+	
+	free(table);
+}
+
+
+/**
+ * Représente une pile d'arbres, un élément par sous-expression en attente de son opérateur.
+ */
+typedef struct {
+	Ast *buf;
+	size_t len;
+	size_t capacity;
+} PileAst;
+
+
+static void ast_empiler(PileAst *P, Ast A) {
+	if(P->len == P->capacity) {
+		P->capacity = P->capacity > 0 ? 2 * P->capacity : 8;
+		P->buf = checked_realloc(P->buf, P->capacity * sizeof(Ast));
+	}
+	
+	P->buf[P->len++] = A;
+}
+
+
+static Ast ast_depiler(PileAst *P) {
+	return P->buf[--P->len];
+}
+
+
+/**
+ * Remplace les deux arbres au sommet de la pile par un nœud binaire du type spécifié ; une suite
+ * d'opérateurs identiques associés à gauche (`a+b+c`) est accumulée dans un seul nœud.
+ */
+static void ast_binaire(PileAst *P, TypeAst type) {
+	Ast B = ast_depiler(P);
+	Ast A = ast_depiler(P);
+	
+	if(A->type != type) {
+		Ast N = ast_noeud(type, '\0');
+		ast_ajouter(N, A);
+		A = N;
+	}
+	
+	ast_ajouter(A, B);
+	ast_empiler(P, A);
+}
+
+
+/**
+ * Actions de construction de l'arbre syntaxique.
+ */
+
+static void ast_symbole(void *ctx, char c) {
+	ast_empiler(ctx, ast_noeud(AST_SYMBOLE, c));
+}
+
+static void ast_unir(void *ctx) {
+	ast_binaire(ctx, AST_UNION);
+}
+
+static void ast_concatener(void *ctx) {
+	ast_binaire(ctx, AST_CONCAT);
+}
+
+static void ast_etoile(void *ctx) {
+	Ast N = ast_noeud(AST_ETOILE, '\0');
+	ast_ajouter(N, ast_depiler(ctx));
+	
+	ast_empiler(ctx, N);
+}
+
+
+/**
+ * Construit l'arbre syntaxique de l'expression régulière spécifiée, sans le simplifier.
+ *
+ * Remarque:
+ * - Une erreur lexicale ou syntaxique termine le programme, comme pour `compile(const char*)`.
+ */
+Ast ast_analyser(const char *s) {
+	PileAst P = { NULL, 0, 0 };
+	
+	Actions actions = { &P, ast_symbole, ast_unir, ast_concatener, ast_etoile };
+	analyser(s, &actions);
+	
+	Ast A = ast_depiler(&P);
+	free(P.buf);
+	
+	return A;
+}
+
+
+/**
+ * Supprime les alternatives en double de l'union simplifiée `U`, en conservant la première de chacune.
+ */
+static void ast_dedoublonner(Ast U) {
+	int *representant = checked_malloc(U->nbFils * sizeof(int));
+	ast_regrouper(U->fils, U->nbFils, representant);
+	
+	int n = 0;
+	for(int i = 0; i < U->nbFils; ++i) {
+		if(representant[i] == i) {
+			U->fils[n++] = U->fils[i];
+		}
+		else {
+			ast_free(U->fils[i]);
+		}
+	}
+	
+	U->nbFils = n;
+	free(representant);
+}
+
+
+/**
+ * Factorise les préfixes communs des alternatives de l'union simplifiée `U` : toutes les alternatives
+ * de la forme `x.r1`, `x.r2`, ... commençant par un même `x` sont remplacées par `x.(r1 + r2 + ...)`,
+ * à la place de la première d'entre elles.
+ *
+ * Les alternatives réduites à `x` ne sont pas factorisées, faute de mot vide dans la grammaire.
+ */
+static void ast_factoriser(Ast U) {
+	const int n = U->nbFils;
+	Ast *alternatives = U->fils;
+	
+	U->fils = NULL;
+	U->nbFils = 0;
+	U->capacity = 0;
+	
+	// `tetes[i]` : le premier facteur de l'alternative `i`, si c'est une concaténation
+	Ast *tetes = checked_malloc(n * sizeof(Ast));
+	int *representant = checked_malloc(n * sizeof(int));
+	int *taille = checked_malloc(n * sizeof(int));
+	
+	for(int i = 0; i < n; ++i) {
+		tetes[i] = (alternatives[i]->type == AST_CONCAT) ? alternatives[i]->fils[0] : NULL;
+		taille[i] = 0;
+	}
+	
+	ast_regrouper(tetes, n, representant);
+	for(int i = 0; i < n; ++i) {
+		if(representant[i] != -1) {
+			++taille[representant[i]];
+		}
+	}
+	
+	// `restes[r]` : l'union des restes du groupe de représentant `r`, dont le résultat ira dans `U->fils[position[r]]`
+	Ast *restes = checked_malloc(n * sizeof(Ast));
+	int *position = checked_malloc(n * sizeof(int));
+	
+	for(int i = 0; i < n; ++i) {
+		Ast X = alternatives[i];
+		int r = representant[i];
+		
+		if(r == -1 || taille[r] == 1) {
+			ast_ajouter(U, X);
+			continue;
+		}
+		
+		if(r == i) {
+			restes[r] = ast_noeud(AST_UNION, '\0');
+			position[r] = U->nbFils;
+			ast_ajouter(U, NULL);
+		}
+		
+		Ast reste = X->fils[1];
+		if(X->nbFils > 2) {
+			reste = ast_noeud(AST_CONCAT, '\0');
+			for(int k = 1; k < X->nbFils; ++k) {
+				ast_ajouter(reste, X->fils[k]);
+			}
+		}
+		
+		ast_ajouter(restes[r], reste);
+		
+		// seul le premier facteur du représentant est conservé
+		if(r != i) {
+			ast_free(X->fils[0]);
+		}
+		
+		ast_free_noeud(X);
+	}
+	
+	for(int r = 0; r < n; ++r) {
+		if(representant[r] != r || taille[r] == 1) {
+			continue;
+		}
+		
+		Ast N = ast_noeud(AST_CONCAT, '\0');
+		ast_ajouter(N, tetes[r]);
+		ast_ajouter_aplati(N, ast_simplifier(restes[r]));
+		ast_calculer_empreinte(N);
+		
+		U->fils[position[r]] = N;
+	}
+	
+	free(alternatives);
+	free(tetes);
+	free(representant);
+	free(taille);
+	free(restes);
+	free(position);
+}
+
+
+/**
+ * Simplifie l'arbre spécifié sans changer son langage, et renvoie le nouvel arbre ; l'arbre spécifié ne doit
+ * plus être utilisé ensuite. Les réécritures appliquées sont :
+ * - `a** → a*` ;
+ * - l'aplatissement des unions et des concaténations imbriquées ;
+ * - la suppression des alternatives en double : `a+b+a → a+b` ;
+ * - la factorisation des préfixes communs des alternatives : `ab+ac → a(b+c)`.
+ */
+Ast ast_simplifier(Ast A) {
+	if(A->type == AST_SYMBOLE) {
+		ast_calculer_empreinte(A);
+		return A;
+	}
+	
+	if(A->type == AST_ETOILE) {
+		Ast F = ast_simplifier(A->fils[0]);
+		if(F->type == AST_ETOILE) {
+			ast_free_noeud(A);
+			return F;
+		}
+		
+		A->fils[0] = F;
+		ast_calculer_empreinte(A);
+		return A;
+	}
+	
+	// les fils sont simplifiés puis aplatis dans un nouveau tableau
+	int n = A->nbFils;
+	Ast *fils = A->fils;
+	
+	A->fils = NULL;
+	A->nbFils = 0;
+	A->capacity = 0;
+	
+	for(int i = 0; i < n; ++i) {
+		ast_ajouter_aplati(A, ast_simplifier(fils[i]));
+	}
+	
+	free(fils);
+	
+	if(A->type == AST_UNION) {
+		ast_dedoublonner(A);
+		ast_factoriser(A);
+	}
+	
+	if(A->nbFils == 1) {
+		Ast F = A->fils[0];
+		ast_free_noeud(A);
+		
+		return F;
+	}
+	
+	ast_calculer_empreinte(A);
+	return A;
+}
+
+
+/**
+ * Exécute les actions spécifiées sur l'arbre spécifié, dans l'ordre où l'analyseur syntaxique les exécuterait.
+ */
+void ast_rejouer(Ast A, const Actions *actions) {
+	switch(A->type) {
+		case AST_SYMBOLE:
+			actions->symbole(actions->ctx, A->c);
+			break;
+		case AST_ETOILE:
+			ast_rejouer(A->fils[0], actions);
+			actions->etoile(actions->ctx);
+			break;
+		case AST_UNION:
+		case AST_CONCAT:
+			ast_rejouer(A->fils[0], actions);
+			
+			for(int i = 1; i < A->nbFils; ++i) {
+				ast_rejouer(A->fils[i], actions);
+				
+				if(A->type == AST_UNION) {
+					actions->unir(actions->ctx);
+				}
+				else {
+					actions->concatener(actions->ctx);
+				}
+			}
+			break;
+	}
+}
+
+
+/**
+ * Renvoie le nombre de symboles (feuilles) de l'arbre spécifié.
+ */
+int ast_nb_symboles(Ast A) {
+	if(A->type == AST_SYMBOLE) {
+		return 1;
+	}
+	
+	int n = 0;
+	for(int i = 0; i < A->nbFils; ++i) {
+		n += ast_nb_symboles(A->fils[i]);
+	}
+	
+	return n;
+}
+
+
+/**
+ * Représente une chaîne de caractères en construction.
+ */
+typedef struct {
+	char *buf;
+	size_t len;
+	size_t capacity;
+} Texte;
+
+
+static void texte_ajouter(Texte *T, char c) {
+	if(T->len + 1 >= T->capacity) {
+		T->capacity = (T->capacity == 0) ? 32 : (T->capacity * 2);
+		T->buf = checked_realloc(T->buf, T->capacity);
+	}
+	
+	T->buf[T->len++] = c;
+	T->buf[T->len] = '\0';
+}
+
+
+/**
+ * Écrit l'expression de l'arbre `A` dans `T`, entre parenthèses si elle est fille d'un nœud de type `parent`
+ * qui lie plus fortement qu'elle (ou du même type, pour montrer les imbrications non aplaties).
+ */
+static void ast_ecrire(Ast A, TypeAst parent, int racine, Texte *T) {
+	if(A->type == AST_SYMBOLE) {
+		texte_ajouter(T, A->c);
+		return;
+	}
+	
+	int parentheses = 0;
+	if(!racine) {
+		switch(parent) {
+			case AST_ETOILE:  parentheses = A->type != AST_ETOILE; break;
+			case AST_CONCAT:  parentheses = A->type == AST_UNION || A->type == AST_CONCAT; break;
+			case AST_UNION:   parentheses = A->type == AST_UNION; break;
+			case AST_SYMBOLE: break;
+		}
+	}
+	
+	if(parentheses) {
+		texte_ajouter(T, '(');
+	}
+	
+	if(A->type == AST_ETOILE) {
+		ast_ecrire(A->fils[0], AST_ETOILE, 0, T);
+		texte_ajouter(T, '*');
+	}
+	else {
+		for(int i = 0; i < A->nbFils; ++i) {
+			if(i > 0 && A->type == AST_UNION) {
+				texte_ajouter(T, '+');
+			}
+			
+			ast_ecrire(A->fils[i], A->type, 0, T);
+		}
+	}
+	
+	if(parentheses) {
+		texte_ajouter(T, ')');
+	}
+}
+
+
+/**
+ * Renvoie l'expression régulière représentée par l'arbre spécifié, avec le moins de parenthèses possible.
+ * La chaîne renvoyée doit être libérée avec `free()`.
+ */
+char* ast_expression(Ast A) {
+	Texte T = { NULL, 0, 0 };
+	ast_ecrire(A, A->type, 1, &T);
+	
+	return T.buf;
+}
+
+
+static void ast_print_indente(Ast A, int profondeur) {
+	printf("%*s", 2 * profondeur, "");
+	
+	switch(A->type) {
+		case AST_SYMBOLE: printf("%c\n", A->c); return;
+		case AST_UNION:   printf("+\n"); break;
+		case AST_CONCAT:  printf(".\n"); break;
+		case AST_ETOILE:  printf("*\n"); break;
+	}
+	
+	for(int i = 0; i < A->nbFils; ++i) {
+		ast_print_indente(A->fils[i], profondeur + 1);
+	}
+}
+
+
+/**
+ * Affiche l'arbre spécifié dans le flux de sortie standard, un nœud par ligne.
+ */
+void ast_print(Ast A) {
+	ast_print_indente(A, 0);
+}
+
+
+/**
+ * Libère les ressources allouées à un arbre syntaxique.
+ */
+void ast_free(Ast A) {
+	for(int i = 0; i < A->nbFils; ++i) {
+		ast_free(A->fils[i]);
+	}
+	
+	ast_free_noeud(A);
+}
@@ -0,0 +1,110 @@
+#ifndef AST_H
+#define AST_H
+
+#include <stddef.h>
+
+#include "compregex.h"
+
+/**
+ * Représente le type d'un nœud de l'arbre syntaxique.
+ */
+typedef enum {
+	AST_SYMBOLE,
+	AST_UNION,
+	AST_CONCAT,
+	AST_ETOILE
+} TypeAst;
+
+
+/**
+ * Représente l'arbre syntaxique abstrait (AST) d'une expression régulière.
+ *
+ * L'union et la concaténation sont n-aires : leurs fils sont rangés de gauche à droite dans `fils`,
+ * si bien qu'une suite de concaténations ou d'unions n'est qu'un seul nœud.
+ */
+struct Ast {
+	/**
+	 * Le type du nœud.
+	 */
+	TypeAst type;
+	
+	/**
+	 * Le symbole d'un nœud `AST_SYMBOLE`.
+	 */
+	char c;
+	
+	/**
+	 * Les fils du nœud : aucun pour un symbole, un seul pour une étoile, au moins deux sinon.
+	 */
+	struct Ast **fils;
+	
+	/**
+	 * Le nombre de fils du nœud.
+	 */
+	int nbFils;
+	
+	/**
+	 * La taille du tableau `fils`.
+	 */
+	int capacity;
+	
+	/**
+	 * L'empreinte du nœud, calculée par `ast_simplifier(Ast)` : deux arbres identiques ont la même empreinte.
+	 */
+	size_t empreinte;
+};
+
+typedef struct Ast* Ast;
+
+
+/**
+ * Construit l'arbre syntaxique de l'expression régulière spécifiée, sans le simplifier.
+ *
+ * Remarque:
+ * - Une erreur lexicale ou syntaxique termine le programme, comme pour `compile(const char*)`.
+ */
+Ast ast_analyser(const char *s);
+
+
+/**
+ * Simplifie l'arbre spécifié sans changer son langage, et renvoie le nouvel arbre ; l'arbre spécifié ne doit
+ * plus être utilisé ensuite. Les réécritures appliquées sont :
+ * - `a** → a*` ;
+ * - l'aplatissement des unions et des concaténations imbriquées ;
+ * - la suppression des alternatives en double : `a+b+a → a+b` ;
+ * - la factorisation des préfixes communs des alternatives : `ab+ac → a(b+c)`.
+ */
+Ast ast_simplifier(Ast A);
+
+
+/**
+ * Exécute les actions spécifiées sur l'arbre spécifié, dans l'ordre où l'analyseur syntaxique les exécuterait.
+ */
+void ast_rejouer(Ast A, const Actions *actions);
+
+
+/**
+ * Renvoie le nombre de symboles (feuilles) de l'arbre spécifié.
+ */
+int ast_nb_symboles(Ast A);
+
+
+/**
+ * Renvoie l'expression régulière représentée par l'arbre spécifié, avec le moins de parenthèses possible.
+ * La chaîne renvoyée doit être libérée avec `free()`.
+ */
+char* ast_expression(Ast A);
+
+
+/**
+ * Affiche l'arbre spécifié dans le flux de sortie standard, un nœud par ligne.
+ */
+void ast_print(Ast A);
+
+
+/**
+ * Libère les ressources allouées à un arbre syntaxique.
+ */
+void ast_free(Ast A);
+
+#endif // AST_H
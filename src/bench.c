@@ -0,0 +1,757 @@
+#include <regex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "afd.h"
+#include "afdc.h"
+#include "afn.h"
+#include "afnb.h"
+#include "cache.h"
+#include "chargeur.h"
+#include "compregex.h"
+#include "derivee.h"
+#include "glushkov.h"
+#include "multi.h"
+#include "recherche.h"
+#include "util/misc.h"
+
+/**
+ * Vaut `1` si les résultats sont affichés en JSON, un objet par ligne (option `-j`), sinon `0`.
+ */
+static int json = 0;
+
+/**
+ * Le nom de la section en cours, repris dans chaque résultat JSON.
+ */
+static const char *section = "";
+
+/**
+ * Renvoie le temps écoulé (en secondes) depuis une origine arbitraire.
+ */
+static double maintenant() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+/**
+ * Renvoie une chaîne aléatoire de `n` caractères choisis dans `alphabet`, terminée par '\0'.
+ */
+static char* chaine_aleatoire(size_t n, const char *alphabet) {
+	size_t k = strlen(alphabet);
+	char *s = checked_malloc(n + 1);
+	
+	for(size_t i = 0; i < n; ++i) {
+		s[i] = alphabet[rand() % k];
+	}
+	
+	s[n] = '\0';
+	return s;
+}
+
+
+/**
+ * Affiche la chaîne spécifiée entre guillemets, échappée pour JSON.
+ */
+static void afficher_chaine_json(const char *s) {
+	putchar('"');
+	for(; *s != '\0'; ++s) {
+		if(*s == '"' || *s == '\\') {
+			putchar('\\');
+		}
+		
+		putchar(*s);
+	}
+	putchar('"');
+}
+
+
+/**
+ * Affiche le début d'un résultat JSON, jusqu'au motif compris.
+ */
+static void afficher_entete_json(const char *mesure, const char *moteur, const char *motif) {
+	printf("{\"section\":");
+	afficher_chaine_json(section);
+	printf(",\"mesure\":\"%s\",\"moteur\":", mesure);
+	afficher_chaine_json(moteur);
+	printf(",\"motif\":");
+	afficher_chaine_json(motif);
+}
+
+
+/**
+ * Affiche le débit de `repetitions` simulations de `n` octets ayant duré `t` secondes au total.
+ */
+static void afficher_debit(const char *moteur, const char *motif, size_t n, int repetitions, double t, int resultat) {
+	double debit = (double) n * repetitions / t / 1e6;
+	
+	if(json) {
+		afficher_entete_json("debit", moteur, motif);
+		printf(",\"octets\":%zu,\"repetitions\":%d,\"secondes\":%.6f,\"mo_s\":%.1f,\"resultat\":%d}\n",
+			n, repetitions, t, debit, resultat);
+	}
+	else {
+		printf("%-14s %-28s %10zu octets %8.1f Mo/s (%s)\n", moteur, motif, n, debit, resultat ? "acceptée" : "rejetée");
+	}
+}
+
+
+/**
+ * Affiche la durée moyenne `t` (en secondes) d'une opération portant sur un objet de taille `taille`,
+ * mesurée en `unite` (p. ex. des états ou des transitions).
+ */
+static void afficher_temps(const char *moteur, const char *motif, long taille, const char *unite, double t) {
+	if(json) {
+		afficher_entete_json("temps", moteur, motif);
+		printf(",\"taille\":%ld,\"unite\":\"%s\",\"secondes\":%.9f}\n", taille, unite, t);
+	}
+	else {
+		printf("%-14s %-28s %10ld %-11s %12.1f µs\n", moteur, motif, taille, unite, t * 1e6);
+	}
+}
+
+
+/**
+ * Affiche la mémoire résidente maximale (en Kio) atteinte par la section spécifiée.
+ */
+static void afficher_memoire(const char *nom, long kio) {
+	if(json) {
+		printf("{\"section\":");
+		afficher_chaine_json(nom);
+		printf(",\"mesure\":\"memoire\",\"rss_max_kio\":%ld}\n", kio);
+	}
+	else {
+		printf("%-14s %-28s %10ld Kio (pic de mémoire résidente)\n\n", "memoire", nom, kio);
+	}
+}
+
+
+/**
+ * Compile l'expression régulière spécifiée avec `regcomp()`, après l'avoir traduite en expression POSIX étendue
+ * reconnaissant les mêmes mots entiers : `+` devient `|`, les `.` disparaissent et l'expression est ancrée.
+ */
+static void regex_compiler(regex_t *re, const char *motif) {
+	size_t n = strlen(motif);
+	char *posix = checked_malloc(n + 5);
+	char *p = posix;
+	
+	*p++ = '^';
+	*p++ = '(';
+	for(size_t i = 0; i < n; ++i) {
+		if(motif[i] == '+') {
+			*p++ = '|';
+		}
+		else if(motif[i] != '.') {
+			*p++ = motif[i];
+		}
+	}
+	*p++ = ')';
+	*p++ = '$';
+	*p = '\0';
+	
+	if(regcomp(re, posix, REG_EXTENDED | REG_NOSUB) != 0) {
+		fprintf(stderr, "regcomp(): expression refusée: %s\n", posix);
+		exit(1);
+	}
+	
+	free(posix);
+}
+
+
+/**
+ * Mesure le débit de `afd_simuler()` et de `afdc_simuler_n()` sur une longue chaîne.
+ */
+static void bench_debit(const char *motif, size_t n) {
+	AFN A = compile(motif);
+	AFD D = afn_determiniser(A);
+	AFDC T = afdc_compiler(D);
+	
+	char *s = chaine_aleatoire(n, "ab");
+	
+	double t0 = maintenant();
+	int r = afd_simuler(D, s);
+	afficher_debit("afd_simuler", motif, n, 1, maintenant() - t0, r);
+	
+	t0 = maintenant();
+	r = afdc_simuler_n(T, s, n);
+	afficher_debit("afdc_simuler", motif, n, 1, maintenant() - t0, r);
+	
+	free(s);
+	afdc_free(T);
+	afd_free(D);
+	afn_free(A);
+}
+
+/**
+ * Mesure le débit de `afdc_simuler_parallele()` pour 1, 2, 4 et 8 threads, par rapport à `afdc_simuler_n()`.
+ */
+static void bench_parallele(const char *motif, size_t n) {
+	AFN A = compile(motif);
+	AFD D = afn_determiniser(A);
+	AFDC T = afdc_compiler(D);
+	
+	char *s = chaine_aleatoire(n, "ab");
+	
+	double t0 = maintenant();
+	int r = afdc_simuler_n(T, s, n);
+	double serie = maintenant() - t0;
+	afficher_debit("afdc_simuler", motif, n, 1, serie, r);
+	
+	for(int nbThreads = 1; nbThreads <= 8; nbThreads *= 2) {
+		char moteur[32];
+		sprintf(moteur, "parallele/%d", nbThreads);
+		
+		t0 = maintenant();
+		r = afdc_simuler_parallele(T, s, n, nbThreads);
+		double t = maintenant() - t0;
+		
+		afficher_debit(moteur, motif, n, 1, t, r);
+		if(!json) {
+			printf("%-14s accélération x%.2f\n", "", serie / t);
+		}
+	}
+	
+	free(s);
+	afdc_free(T);
+	afd_free(D);
+	afn_free(A);
+}
+
+/**
+ * Mesure le débit de `afdc_simuler_lot()` sur `nb` chaînes courtes de 4 à 24 octets, par rapport à
+ * un appel de `afdc_simuler_n()` par chaîne.
+ */
+static void bench_lot(const char *motif, size_t nb) {
+	AFN A = compile(motif);
+	AFD D = afn_determiniser(A);
+	AFDC T = afdc_compiler(D);
+	
+	char **chaines = checked_malloc(nb * sizeof(char*));
+	size_t *longueurs = checked_malloc(nb * sizeof(size_t));
+	unsigned char *resultats = checked_malloc(nb);
+	size_t total = 0;
+	
+	for(size_t i = 0; i < nb; ++i) {
+		longueurs[i] = 4 + rand() % 21;
+		chaines[i] = chaine_aleatoire(longueurs[i], "ab");
+		total += longueurs[i];
+	}
+	
+	char nom[32];
+	snprintf(nom, sizeof(nom), "%zu chaînes (%zu états)", nb, (size_t) D->Q + 1);
+	
+	double t0 = maintenant();
+	long r = 0;
+	for(size_t i = 0; i < nb; ++i) {
+		r += afdc_simuler_n(T, chaines[i], longueurs[i]);
+	}
+	afficher_debit("afdc_simuler", nom, total, 1, maintenant() - t0, r > 0);
+	
+	t0 = maintenant();
+	afdc_simuler_lot(T, (const char**) chaines, longueurs, nb, resultats);
+	afficher_debit("afdc_lot", nom, total, 1, maintenant() - t0, resultats[0]);
+	
+	for(size_t i = 0; i < nb; ++i) {
+		free(chaines[i]);
+	}
+	
+	free(chaines);
+	free(longueurs);
+	free(resultats);
+	afdc_free(T);
+	afd_free(D);
+	afn_free(A);
+}
+
+/**
+ * Mesure le débit de `afn_simuler()` avant et après avoir figé l'AFN, puis sur l'AFN privé de ses
+ * epsilon-transitions, puis celui de `afnb_simuler()`, et enfin celui de l'automate des positions.
+ */
+static void bench_debit_afn(const char *motif, size_t n) {
+	AFN A = compile(motif);
+	char *s = chaine_aleatoire(n, "ab");
+	
+	double t0 = maintenant();
+	int r = afn_simuler(A, s);
+	afficher_debit("afn_simuler", motif, n, 1, maintenant() - t0, r);
+	
+	afn_figer(A);
+	
+	t0 = maintenant();
+	r = afn_simuler(A, s);
+	afficher_debit("afn_csr", motif, n, 1, maintenant() - t0, r);
+	
+	AFN E = afn_supprimer_epsilon(A);
+	
+	t0 = maintenant();
+	r = afn_simuler(E, s);
+	afficher_debit("afn_sans_eps", motif, n, 1, maintenant() - t0, r);
+	
+	AFNB B = afnb_compiler(A);
+	
+	t0 = maintenant();
+	r = afnb_simuler(B, s);
+	afficher_debit("afnb_simuler", motif, n, 1, maintenant() - t0, r);
+	
+	Glushkov G = glushkov_compiler(motif);
+	
+	t0 = maintenant();
+	r = glushkov_simuler_n(G, s, n);
+	afficher_debit("glushkov", motif, n, 1, maintenant() - t0, r);
+	
+	glushkov_free(G);
+	afnb_free(B);
+	free(s);
+	afn_free(E);
+	afn_free(A);
+}
+
+/**
+ * Mesure le temps de construction d'un AFD, d'abord par `compile()` puis `afn_determiniser()`, ensuite
+ * directement par `derivee_compiler()`.
+ */
+static void bench_compilation(const char *motif, int repetitions) {
+	char nom[32];
+	snprintf(nom, sizeof(nom), "%.24s%s", motif, strlen(motif) > 24 ? "..." : "");
+	
+	int Q = 0;
+	double t0 = maintenant();
+	for(int i = 0; i < repetitions; ++i) {
+		AFN A = compile(motif);
+		AFD D = afn_determiniser(A);
+		Q = D->Q + 1;
+		afd_free(D);
+		afn_free(A);
+	}
+	afficher_temps("sous-ens.", nom, Q, "états", (maintenant() - t0) / repetitions);
+	
+	t0 = maintenant();
+	for(int i = 0; i < repetitions; ++i) {
+		AFD D = derivee_compiler(motif);
+		Q = D->Q + 1;
+		afd_free(D);
+	}
+	afficher_temps("derivees", nom, Q, "états", (maintenant() - t0) / repetitions);
+}
+
+/**
+ * Mesure le débit d'une recherche de `nbMotifs` motifs sur des lignes de 64 octets : d'abord un automate
+ * de recherche par motif, puis un seul automate combiné (`multi_executer()`).
+ */
+static void bench_multi(int nbMotifs, size_t n) {
+	const size_t largeur = 64;
+	const char *lettres = "abcdefgh";
+	
+	// motifs de la forme `xyz(0+1)*w`, où `x`, `y`, `z` et `w` sont des lettres distinctes d'un motif à l'autre
+	char **motifs = checked_malloc(nbMotifs * sizeof(char*));
+	Recherche *R = checked_malloc(nbMotifs * sizeof(Recherche));
+	
+	for(int i = 0; i < nbMotifs; ++i) {
+		motifs[i] = checked_malloc(16);
+		sprintf(motifs[i], "%c%c%c(0+1)*%c", lettres[i % 8], lettres[(i / 8) % 8], lettres[(i / 64) % 8], lettres[(i * 7) % 8]);
+		
+		AFN A = compile(motifs[i]);
+		R[i] = recherche_compiler(A);
+		afn_free(A);
+	}
+	
+	Multi M = multi_compiler((const char**) motifs, nbMotifs, 1);
+	int *resultats = checked_malloc(nbMotifs * sizeof(int));
+	
+	char *s = chaine_aleatoire(n, "abcdefgh01");
+	char nom[32];
+	sprintf(nom, "%d motifs", nbMotifs);
+	
+	double t0 = maintenant();
+	long r = 0;
+	for(size_t i = 0; i + largeur <= n; i += largeur) {
+		for(int j = 0; j < nbMotifs; ++j) {
+			r += recherche_executer(R[j], s + i, largeur, NULL) != -1;
+		}
+	}
+	afficher_debit("recherche", nom, n, 1, maintenant() - t0, r > 0);
+	
+	t0 = maintenant();
+	r = 0;
+	for(size_t i = 0; i + largeur <= n; i += largeur) {
+		r += multi_executer(M, s + i, largeur, MULTI_TOUS, resultats);
+	}
+	afficher_debit("multi", nom, n, 1, maintenant() - t0, r > 0);
+	
+	for(int i = 0; i < nbMotifs; ++i) {
+		recherche_free(R[i]);
+		free(motifs[i]);
+	}
+	
+	multi_free(M);
+	free(resultats);
+	free(motifs);
+	free(R);
+	free(s);
+}
+
+/**
+ * Écrit dans `out/` un AFN et un AFD aléatoires de `nbTransitions` transitions, puis mesure leur temps
+ * de chargement par `afn_finit()` et `afd_finit()`, puis par le chargeur en bloc avec 1 et 4 threads.
+ */
+static void bench_chargement(int nbTransitions) {
+	const int Q = nbTransitions / 4;
+	const char *Sigma = "abcdefghij";
+	
+	// les chargeurs cherchent leurs fichiers dans `resources/`
+	const char *chemins[] = { "out/bench.afn", "out/bench.afd" };
+	const char *noms[] = { "../out/bench.afn", "../out/bench.afd" };
+	
+	for(int k = 0; k < 2; ++k) {
+		FILE *f = fopen(chemins[k], "w");
+		if(f == NULL) {
+			fprintf(stderr, "fichier inaccessible: %s\n", chemins[k]);
+			exit(1);
+		}
+		
+		if(k == 0) {
+			fprintf(f, "%d\n1\n0\n2\n%d %d\n%s\n", Q, Q - 1, Q, Sigma);
+		}
+		else {
+			fprintf(f, "%d\n0\n2\n%d %d\n%s\n", Q, Q - 1, Q, Sigma);
+		}
+		
+		for(int i = 0; i < nbTransitions; ++i) {
+			fprintf(f, "%d %c %d\n", rand() % (Q + 1), Sigma[rand() % 10], rand() % (Q + 1));
+		}
+		
+		fclose(f);
+	}
+	
+	double t0 = maintenant();
+	afn_free(afn_finit(noms[0]));
+	afficher_temps("afn_finit", "", nbTransitions, "transitions", maintenant() - t0);
+	
+	for(int nbThreads = 1; nbThreads <= 4; nbThreads *= 4) {
+		char moteur[32];
+		snprintf(moteur, sizeof(moteur), "chargeur_afn/%d", nbThreads);
+		
+		t0 = maintenant();
+		afn_free(chargeur_afn(noms[0], nbThreads));
+		afficher_temps(moteur, "", nbTransitions, "transitions", maintenant() - t0);
+	}
+	
+	t0 = maintenant();
+	afd_free(afd_finit((char*) noms[1]));
+	afficher_temps("afd_finit", "", nbTransitions, "transitions", maintenant() - t0);
+	
+	for(int nbThreads = 1; nbThreads <= 4; nbThreads *= 4) {
+		char moteur[32];
+		snprintf(moteur, sizeof(moteur), "chargeur_afd/%d", nbThreads);
+		
+		t0 = maintenant();
+		afd_free(chargeur_afd(noms[1], nbThreads));
+		afficher_temps(moteur, "", nbTransitions, "transitions", maintenant() - t0);
+	}
+	
+	remove(chemins[0]);
+	remove(chemins[1]);
+}
+
+/**
+ * Renvoie le motif `(a+b)*a(a+b)...(a+b)` comptant `k` fois `(a+b)` après le `a` ; son AFD minimal possède
+ * `2^(k+1)` états. La chaîne renvoyée doit être libérée avec `free()`.
+ */
+static char* motif_suffixe(int k) {
+	char *motif = checked_malloc(8 + 5 * k);
+	strcpy(motif, "(a+b)*a");
+	
+	for(int i = 0; i < k; ++i) {
+		strcat(motif, "(a+b)");
+	}
+	
+	return motif;
+}
+
+
+/**
+ * Mesure le temps de `compile()` en fonction de la longueur du motif, par rapport à `regcomp()`.
+ */
+static void bench_compilation_longueur(const char *motif, int repetitions) {
+	char nom[32];
+	snprintf(nom, sizeof(nom), "%.24s%s", motif, strlen(motif) > 24 ? "..." : "");
+	
+	double t0 = maintenant();
+	for(int i = 0; i < repetitions; ++i) {
+		afn_free(compile(motif));
+	}
+	afficher_temps("compile", nom, strlen(motif), "octets", (maintenant() - t0) / repetitions);
+	
+	t0 = maintenant();
+	for(int i = 0; i < repetitions; ++i) {
+		regex_t re;
+		regex_compiler(&re, motif);
+		regfree(&re);
+	}
+	afficher_temps("regcomp", nom, strlen(motif), "octets", (maintenant() - t0) / repetitions);
+}
+
+
+/**
+ * Mesure le temps d'obtention de l'AFN d'un motif par `compile()`, puis par `cache_compiler()` une fois le motif
+ * présent dans le cache.
+ */
+static void bench_cache(const char *motif, int repetitions) {
+	char nom[32];
+	snprintf(nom, sizeof(nom), "%.24s%s", motif, strlen(motif) > 24 ? "..." : "");
+	
+	double t0 = maintenant();
+	for(int i = 0; i < repetitions; ++i) {
+		afn_free(compile(motif));
+	}
+	afficher_temps("compile", nom, strlen(motif), "octets", (maintenant() - t0) / repetitions);
+	
+	Cache C = cache_init(0, 0);
+	cache_rendre(C, cache_compiler(C, motif));
+	
+	t0 = maintenant();
+	for(int i = 0; i < repetitions; ++i) {
+		cache_rendre(C, cache_compiler(C, motif));
+	}
+	afficher_temps("cache", nom, strlen(motif), "octets", (maintenant() - t0) / repetitions);
+	
+	cache_free(C);
+}
+
+
+/**
+ * Mesure le débit de `afd_simuler()`, `afn_simuler()` et `regexec()` sur une chaîne de `n` octets, répétée
+ * jusqu'à lire au moins `total` octets (divisé par 16 pour les simulateurs plus lents que l'AFD).
+ */
+static void bench_simulation(const char *motif, size_t n, size_t total) {
+	AFN A = compile(motif);
+	AFD D = afn_determiniser(A);
+	char *s = chaine_aleatoire(n, "ab");
+	
+	regex_t re;
+	regex_compiler(&re, motif);
+	
+	char nom[32];
+	snprintf(nom, sizeof(nom), "%d états (AFD)", D->Q + 1);
+	
+	int repetitions = (total + n - 1) / n;
+	double t0 = maintenant();
+	int r = 0;
+	for(int i = 0; i < repetitions; ++i) {
+		r = afd_simuler(D, s);
+	}
+	afficher_debit("afd_simuler", nom, n, repetitions, maintenant() - t0, r);
+	
+	repetitions = (total / 16 + n - 1) / n;
+	t0 = maintenant();
+	for(int i = 0; i < repetitions; ++i) {
+		r = afn_simuler(A, s);
+	}
+	afficher_debit("afn_simuler", nom, n, repetitions, maintenant() - t0, r);
+	
+	t0 = maintenant();
+	for(int i = 0; i < repetitions; ++i) {
+		r = regexec(&re, s, 0, NULL, 0) == 0;
+	}
+	afficher_debit("regexec", nom, n, repetitions, maintenant() - t0, r);
+	
+	regfree(&re);
+	free(s);
+	afd_free(D);
+	afn_free(A);
+}
+
+
+static void section_debit() {
+	bench_debit("(a+b)*a(a+b)(a+b)", 1 << 26);
+	bench_debit("(a+b)*(ab+ba)*a*", 1 << 26);
+}
+
+static void section_parallele() {
+	bench_parallele("(a+b)*a(a+b)(a+b)", 1 << 28);
+}
+
+static void section_lot() {
+	bench_lot("(a+b)*a(a+b)(a+b)", 1 << 22);
+	bench_lot("(a+b)*a(a+b)(a+b)(a+b)(a+b)(a+b)(a+b)(a+b)(a+b)(a+b)(a+b)(a+b)", 1 << 22);
+}
+
+static void section_afn() {
+	for(int k = 2; k <= 32; k *= 4) {
+		char *motif = motif_suffixe(k);
+		bench_debit_afn(motif, k < 32 ? (1 << 20) : (1 << 18));
+		free(motif);
+	}
+}
+
+static void section_multi() {
+	bench_multi(100, 1 << 20);
+}
+
+static void section_compilation() {
+	for(int k = 1; k <= 256; k *= 4) {
+		char *motif = motif_suffixe(k);
+		bench_compilation_longueur(motif, 4096 / k);
+		free(motif);
+	}
+	
+	// union de `m` mots de 8 lettres
+	for(int m = 16; m <= 4096; m *= 16) {
+		char *motif = checked_malloc(9 * m);
+		char *p = motif;
+		
+		for(int i = 0; i < m; ++i) {
+			if(i > 0) {
+				*p++ = '+';
+			}
+			
+			for(int j = 0; j < 8; ++j) {
+				*p++ = "abcdefgh"[rand() % 8];
+			}
+		}
+		*p = '\0';
+		
+		bench_compilation_longueur(motif, 4096 / m);
+		free(motif);
+	}
+	
+	bench_compilation("(a+b)*a(a+b)(a+b)", 1000);
+	bench_compilation("(ab+ba)*(abc+abd+abe)c*", 1000);
+	bench_compilation("(a+b)*a(a+b)(a+b)(a+b)(a+b)(a+b)(a+b)(a+b)(a+b)", 20);
+	
+	// longue concaténation, dont le temps de construction doit rester linéaire en sa longueur
+	for(int n = 256; n <= 16384; n *= 8) {
+		char *motif = chaine_aleatoire(n, "ab");
+		bench_compilation(motif, 16384 / n);
+		free(motif);
+	}
+}
+
+static void section_cache() {
+	for(int k = 4; k <= 256; k *= 8) {
+		char *motif = motif_suffixe(k);
+		bench_cache(motif, 4096 / k);
+		free(motif);
+	}
+}
+
+static void section_simulation() {
+	for(int k = 2; k <= 10; k += 4) {
+		char *motif = motif_suffixe(k);
+		
+		for(size_t n = 1 << 10; n <= (1 << 22); n <<= 6) {
+			bench_simulation(motif, n, 1 << 26);
+		}
+		
+		free(motif);
+	}
+}
+
+static void section_chargement() {
+	for(int n = 10000; n <= 1000000; n *= 10) {
+		bench_chargement(n);
+	}
+}
+
+
+/**
+ * Représente une section du banc d'essai, exécutable séparément.
+ */
+typedef struct {
+	const char *nom;
+	void (*executer)();
+} Section;
+
+static const Section sections[] = {
+	{ "debit", section_debit },
+	{ "parallele", section_parallele },
+	{ "lot", section_lot },
+	{ "afn", section_afn },
+	{ "multi", section_multi },
+	{ "compilation", section_compilation },
+	{ "cache", section_cache },
+	{ "simulation", section_simulation },
+	{ "chargement", section_chargement }
+};
+
+#define NB_SECTIONS ((int) (sizeof(sections) / sizeof(Section)))
+
+
+/**
+ * Exécute la section spécifiée dans un processus fils, dont le pic de mémoire résidente est ensuite affiché ;
+ * la section est exécutée dans ce processus si le fils n'a pas pu être créé.
+ */
+static void lancer(const Section *S) {
+	section = S->nom;
+	fflush(stdout);
+	
+	pid_t pid = fork();
+	if(pid == 0) {
+		S->executer();
+		fflush(stdout);
+		_exit(0);
+	}
+	
+	struct rusage usage;
+	if(pid == -1) {
+		S->executer();
+		getrusage(RUSAGE_SELF, &usage);
+	}
+	else {
+		int status;
+		if(wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+			fprintf(stderr, "la section %s a échoué\n", S->nom);
+			exit(1);
+		}
+	}
+	
+	// `ru_maxrss` est exprimé en Kio sous Linux
+	afficher_memoire(S->nom, usage.ru_maxrss);
+}
+
+
+int main(int argc, char *argv[]) {
+	int c;
+	while((c = getopt(argc, argv, "j")) != -1) {
+		switch(c) {
+			case 'j': json = 1; break;
+			default:
+				fprintf(stderr, "%s [-j] [section...]\n", argv[0]);
+				exit(1);
+		}
+	}
+	
+	srand(42);
+	
+	// sans argument, toutes les sections sont exécutées
+	if(optind == argc) {
+		for(int i = 0; i < NB_SECTIONS; ++i) {
+			lancer(&sections[i]);
+		}
+		
+		return 0;
+	}
+	
+	for(int k = optind; k < argc; ++k) {
+		int i = 0;
+		while(i < NB_SECTIONS && strcmp(argv[k], sections[i].nom) != 0) {
+			++i;
+		}
+		
+		if(i == NB_SECTIONS) {
+			fprintf(stderr, "section inconnue: %s\n", argv[k]);
+			exit(1);
+		}
+		
+		lancer(&sections[i]);
+	}
+	
+	return 0;
+}
@@ -0,0 +1,470 @@
+#include "binaire.h"
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "util/misc.h"
+
+/**
+ * La signature et la version du format ; la version change à chaque modification incompatible de la disposition.
+ */
+#define BINAIRE_MAGIE "AFBINAIR"
+#define BINAIRE_VERSION 1
+
+/**
+ * Le témoin de boutisme, lu à l'envers sur une machine de boutisme différent.
+ */
+#define BINAIRE_BOUTISME 0x01020304
+
+#define BINAIRE_AFDC 1
+#define BINAIRE_AFN 2
+
+#define BINAIRE_CHAMPS 8
+#define BINAIRE_SECTIONS 8
+
+_Static_assert(sizeof(int) == sizeof(int32_t), "le format binaire suppose des int de 32 bits");
+
+/**
+ * L'en-tête d'un fichier binaire, dont la taille est un multiple de 8.
+ */
+typedef struct {
+	char magie[8];
+	uint32_t version;
+	uint32_t type;
+	uint32_t boutisme;
+	uint32_t nbSections;
+	
+	/**
+	 * La taille totale du fichier, en-tête compris.
+	 */
+	uint64_t taille;
+	
+	/**
+	 * La somme de contrôle des `taille - sizeof(Entete)` octets qui suivent l'en-tête.
+	 */
+	uint64_t somme;
+	
+	int32_t champs[BINAIRE_CHAMPS];
+	
+	/**
+	 * La position (depuis le début du fichier) et la longueur en octets de chaque section.
+	 */
+	uint64_t sections[BINAIRE_SECTIONS][2];
+} Entete;
+
+
+/**
+ * Ajoute `n` octets à la somme de contrôle `h`, mot de 64 bits par mot de 64 bits, le dernier mot étant
+ * complété par des zéros ; `p` doit commencer sur une frontière de mot du fichier.
+ *
+ * Chaque étape est une bijection de `h` : un mot modifié change toujours la somme.
+ */
+static uint64_t somme_ajouter(uint64_t h, const void *p, size_t n) {
+	const unsigned char *o = p;
+	
+	for(; n >= 8; o += 8, n -= 8) {
+		uint64_t w;
+		memcpy(&w, o, 8);
+		
+		h = (((h << 31) | (h >> 33)) ^ w) * 0x100000001B3ULL;
+	}
+	
+	if(n > 0) {
+		uint64_t w = 0;
+		memcpy(&w, o, n);
+		
+		h = (((h << 31) | (h >> 33)) ^ w) * 0x100000001B3ULL;
+	}
+	
+	return h;
+}
+
+
+static size_t aligner(size_t n) {
+	return (n + 7) & ~(size_t) 7;
+}
+
+
+/**
+ * Écrit un fichier binaire dont l'en-tête porte les champs et les sections spécifiés.
+ */
+static void binaire_ecrire(const char *filename, uint32_t type, const int32_t *champs, int nbChamps,
+		const void **sections, const size_t *longueurs, int nbSections) {
+	Entete E;
+	memset(&E, 0, sizeof(Entete));
+	memcpy(E.magie, BINAIRE_MAGIE, 8);
+	E.version = BINAIRE_VERSION;
+	E.type = type;
+	E.boutisme = BINAIRE_BOUTISME;
+	E.nbSections = nbSections;
+	memcpy(E.champs, champs, nbChamps * sizeof(int32_t));
+	
+	uint64_t somme = 0;
+	size_t position = sizeof(Entete);
+	
+	for(int i = 0; i < nbSections; ++i) {
+		E.sections[i][0] = position;
+		E.sections[i][1] = longueurs[i];
+		
+		somme = somme_ajouter(somme, sections[i], longueurs[i]);
+		position += aligner(longueurs[i]);
+	}
+	
+	E.taille = position;
+	E.somme = somme;
+	
+	char *temporaire = concat(filename, ".tmp");
+	FILE *f = fopen(temporaire, "wb");
+	if(f == NULL) {
+		fprintf(stderr, "fichier inaccessible: %s\n", temporaire);
+		exit(1);
+	}
+	
+	static const char zeros[8] = { 0 };
+	int ok = fwrite(&E, sizeof(Entete), 1, f) == 1;
+	
+	for(int i = 0; i < nbSections && ok; ++i) {
+		size_t n = longueurs[i];
+		size_t bourrage = aligner(n) - n;
+		
+		ok = (n == 0 || fwrite(sections[i], n, 1, f) == 1) && (bourrage == 0 || fwrite(zeros, bourrage, 1, f) == 1);
+	}
+	
+	ok = (fclose(f) == 0) && ok;
+	if(!ok || rename(temporaire, filename) != 0) {
+		fprintf(stderr, "erreur d'écriture: %s\n", filename);
+		remove(temporaire);
+		exit(1);
+	}
+	
+	free(temporaire);
+}
+
+
+static void binaire_invalide(const char *filename, const char *raison) {
+	fprintf(stderr, "%s: fichier binaire invalide (%s)\n", filename, raison);
+	exit(1);
+}
+
+
+/**
+ * Projette en mémoire le fichier binaire `filename`, vérifie son en-tête et renvoie le début de la projection.
+ */
+static const unsigned char* binaire_projeter(const char *filename, uint32_t type, int verifier, size_t *taille) {
+	int fd = open(filename, O_RDONLY);
+	if(fd == -1) {
+		fprintf(stderr, "fichier inaccessible: %s\n", filename);
+		exit(1);
+	}
+	
+	struct stat st;
+	if(fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(Entete)) {
+		close(fd);
+		binaire_invalide(filename, "fichier tronqué");
+	}
+	
+	*taille = st.st_size;
+	
+	// la projection partagée reste valide après la fermeture du descripteur
+	void *projection = mmap(NULL, *taille, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	
+	if(projection == MAP_FAILED) {
+		fprintf(stderr, "fichier inaccessible: %s\n", filename);
+		exit(1);
+	}
+	
+	const unsigned char *base = projection;
+	const Entete *E = projection;
+	
+	if(memcmp(E->magie, BINAIRE_MAGIE, 8) != 0) {
+		binaire_invalide(filename, "signature");
+	}
+	
+	if(E->boutisme != BINAIRE_BOUTISME) {
+		binaire_invalide(filename, "boutisme");
+	}
+	
+	if(E->version != BINAIRE_VERSION) {
+		binaire_invalide(filename, "version");
+	}
+	
+	if(E->type != type) {
+		binaire_invalide(filename, "type d'automate");
+	}
+	
+	if(E->taille != *taille) {
+		binaire_invalide(filename, "taille");
+	}
+	
+	if(E->nbSections > BINAIRE_SECTIONS) {
+		binaire_invalide(filename, "nombre de sections");
+	}
+	
+	for(uint32_t i = 0; i < E->nbSections; ++i) {
+		uint64_t position = E->sections[i][0];
+		uint64_t longueur = E->sections[i][1];
+		
+		if(position % 8 != 0 || position < sizeof(Entete) || position > *taille || longueur > *taille - position) {
+			binaire_invalide(filename, "section hors du fichier");
+		}
+	}
+	
+	if(verifier && somme_ajouter(0, base + sizeof(Entete), *taille - sizeof(Entete)) != E->somme) {
+		binaire_invalide(filename, "somme de contrôle");
+	}
+	
+	return base;
+}
+
+
+/**
+ * Renvoie la section `i` du fichier projeté, après avoir vérifié qu'elle contient `nb` éléments de `taille` octets.
+ */
+static void* binaire_section(const char *filename, const unsigned char *base, int i, int64_t nb, size_t taille) {
+	const Entete *E = (const Entete*) base;
+	
+	if(i >= (int) E->nbSections || nb < 0 || E->sections[i][1] != (uint64_t) nb * taille) {
+		binaire_invalide(filename, "taille de section");
+	}
+	
+	return (void*) (base + E->sections[i][0]);
+}
+
+
+/**
+ * Vérifie que chaque octet est associé à une colonne de l'AFDC chargé, et que chaque case de `delta` désigne
+ * le début d'une ligne de la table.
+ */
+static void binaire_verifier_afdc(const char *filename, AFDC T) {
+	const int64_t cases = (int64_t) T->nbEtats * T->nbColonnes;
+	
+	for(int c = 0; c < 256; ++c) {
+		if(T->colonne[c] >= T->nbColonnes) {
+			binaire_invalide(filename, "colonne hors de la table");
+		}
+	}
+	
+	for(int64_t i = 0; i < cases; ++i) {
+		int d = T->delta[i];
+		
+		if(d < 0 || d >= cases || d % T->nbColonnes != 0) {
+			binaire_invalide(filename, "transition hors de la table");
+		}
+	}
+}
+
+
+/**
+ * Écrit l'AFDC spécifié dans le fichier `filename` au format binaire.
+ *
+ * Le fichier est écrit sous un nom temporaire puis renommé : les processus qui projettent déjà l'ancien
+ * fichier continuent de l'utiliser sans le voir changer.
+ */
+void binaire_ecrire_afdc(AFDC T, const char *filename) {
+	size_t cases = (size_t) T->nbEtats * T->nbColonnes;
+	
+	int32_t champs[] = { T->nbEtats, T->nbColonnes, T->q0, T->mort };
+	const void *sections[] = { T->colonne, T->delta, T->finals };
+	size_t longueurs[] = { 256, cases * sizeof(int), cases };
+	
+	binaire_ecrire(filename, BINAIRE_AFDC, champs, 4, sections, longueurs, 3);
+}
+
+
+/**
+ * Charge un AFDC depuis le fichier binaire `filename`, sans recopier ses tables ; il doit être libéré
+ * avec `afdc_free(AFDC)`, qui libère aussi la projection.
+ *
+ * L'en-tête, les champs scalaires (dimensions, `q0` et `mort` alignés sur une ligne) et la taille des sections
+ * sont toujours vérifiés. Si `verifier` est non nul, la somme de contrôle puis le contenu des tables le sont
+ * aussi, ce qui lit le fichier en entier : chaque octet doit désigner une colonne, et chaque case de `delta`
+ * le début d'une ligne de la table.
+ *
+ * Remarque:
+ * - Un fichier inaccessible ou invalide termine le programme. Si `verifier` est nul, le contenu des tables
+ *   n'est pas vérifié : il ne faut alors charger que des fichiers sûrs, écrits par `binaire_ecrire_afdc()`,
+ *   sans quoi la simulation peut lire hors de la projection.
+ */
+AFDC binaire_charger_afdc(const char *filename, int verifier) {
+	size_t taille;
+	const unsigned char *base = binaire_projeter(filename, BINAIRE_AFDC, verifier, &taille);
+	const int32_t *champs = ((const Entete*) base)->champs;
+	
+	AFDC T = checked_malloc(sizeof(struct AFDC));
+	T->nbEtats = champs[0];
+	T->nbColonnes = champs[1];
+	T->q0 = champs[2];
+	T->mort = champs[3];
+	
+	// les états sont prémultipliés : `q0` et `mort` désignent le début d'une ligne
+	int64_t cases = (int64_t) T->nbEtats * T->nbColonnes;
+	if(T->nbEtats < 1 || T->nbColonnes < 1 || T->nbColonnes > 256
+			|| T->q0 < 0 || T->q0 >= cases || T->q0 % T->nbColonnes != 0
+			|| T->mort < 0 || T->mort >= cases || T->mort % T->nbColonnes != 0) {
+		binaire_invalide(filename, "dimensions de la table");
+	}
+	
+	memcpy(T->colonne, binaire_section(filename, base, 0, 256, 1), 256);
+	T->delta = binaire_section(filename, base, 1, cases, sizeof(int));
+	T->finals = binaire_section(filename, base, 2, cases, 1);
+	
+	if(verifier) {
+		binaire_verifier_afdc(filename, T);
+	}
+	
+	T->projection = (void*) base;
+	T->lenProjection = taille;
+	return T;
+}
+
+
+/**
+ * Vérifie que les états initiaux, finaux et d'arrivée de l'AFN chargé sont compris entre `0` et `Q`, et que
+ * sa forme CSR est cohérente : lignes et listes croissantes et bornées, symboles triés dans chaque ligne,
+ * chaque liste terminée par `INVALID_STATE`.
+ */
+static void binaire_verifier_afn(const char *filename, AFN A) {
+	const struct CSR *csr = A->csr;
+	
+	for(int i = 0; i < A->lenI; ++i) {
+		if(A->I[i] < 0 || A->I[i] > A->Q) {
+			binaire_invalide(filename, "état initial hors de l'automate");
+		}
+	}
+	
+	for(int i = 0; i < A->lenF; ++i) {
+		if(A->F[i] < 0 || A->F[i] > A->Q) {
+			binaire_invalide(filename, "état final hors de l'automate");
+		}
+	}
+	
+	if(csr->ligne[0] != 0 || csr->ligne[A->Q + 1] != csr->nbPaires) {
+		binaire_invalide(filename, "lignes de la forme CSR");
+	}
+	
+	for(int q = 0; q <= A->Q; ++q) {
+		if(csr->ligne[q] > csr->ligne[q + 1]) {
+			binaire_invalide(filename, "lignes de la forme CSR");
+		}
+		
+		for(int p = csr->ligne[q]; p < csr->ligne[q + 1]; ++p) {
+			if(csr->symbole[p] < 0 || csr->symbole[p] >= A->lenSigma
+					|| (p > csr->ligne[q] && csr->symbole[p] <= csr->symbole[p - 1])) {
+				binaire_invalide(filename, "symboles de la forme CSR");
+			}
+		}
+	}
+	
+	// chaque liste contient au moins son marqueur de fin, qui est le dernier élément avant la liste suivante
+	if(csr->debut[0] != 0 || csr->debut[csr->nbPaires] != csr->lenDest) {
+		binaire_invalide(filename, "listes de la forme CSR");
+	}
+	
+	for(int p = 0; p < csr->nbPaires; ++p) {
+		if(csr->debut[p] >= csr->debut[p + 1] || csr->dest[csr->debut[p + 1] - 1] != INVALID_STATE) {
+			binaire_invalide(filename, "listes de la forme CSR");
+		}
+	}
+	
+	for(int d = 0; d < csr->lenDest; ++d) {
+		if(csr->dest[d] != INVALID_STATE && (csr->dest[d] < 0 || csr->dest[d] > A->Q)) {
+			binaire_invalide(filename, "état d'arrivée hors de l'automate");
+		}
+	}
+}
+
+
+/**
+ * Écrit l'AFN spécifié dans le fichier `filename` au format binaire ; l'AFN est d'abord figé s'il ne l'est pas.
+ *
+ * Voir aussi:
+ * - `binaire_ecrire_afdc(AFDC, const char*)`
+ */
+void binaire_ecrire_afn(AFN A, const char *filename) {
+	afn_figer(A);
+	const struct CSR *csr = A->csr;
+	
+	int32_t champs[] = { A->Q, A->lenI, A->lenF, A->lenSigma, A->sansEpsilon, csr->nbPaires, csr->lenDest };
+	const void *sections[] = { A->Sigma, A->I, A->F, csr->ligne, csr->symbole, csr->debut, csr->dest };
+	size_t longueurs[] = {
+		A->lenSigma + 1,
+		A->lenI * sizeof(int),
+		A->lenF * sizeof(int),
+		(A->Q + 2) * sizeof(int),
+		csr->nbPaires * sizeof(int),
+		(csr->nbPaires + 1) * sizeof(int),
+		csr->lenDest * sizeof(int)
+	};
+	
+	binaire_ecrire(filename, BINAIRE_AFN, champs, 7, sections, longueurs, 7);
+}
+
+
+/**
+ * Charge un AFN figé depuis le fichier binaire `filename`, sans recopier ses tableaux ; il doit être libéré
+ * avec `afn_free(AFN)`, qui libère aussi la projection.
+ *
+ * L'AFN chargé n'a que sa forme figée (`delta` vaut `NULL`) : il peut être simulé, déterminisé ou inversé,
+ * mais pas combiné à d'autres AFN, affiché ou dessiné.
+ *
+ * Si `verifier` est non nul, le contenu des tableaux est vérifié après la somme de contrôle : les états
+ * initiaux, finaux et d'arrivée doivent être compris entre `0` et `Q`, les lignes et les listes de la forme
+ * CSR croissantes et bornées par `nbPaires` et `lenDest`, les symboles d'une ligne triés, et chaque liste
+ * terminée par `INVALID_STATE`. Sinon, seuls l'en-tête, l'alphabet et la taille des sections le sont.
+ *
+ * Voir aussi:
+ * - `binaire_charger_afdc(const char*, int)`
+ */
+AFN binaire_charger_afn(const char *filename, int verifier) {
+	size_t taille;
+	const unsigned char *base = binaire_projeter(filename, BINAIRE_AFN, verifier, &taille);
+	const int32_t *champs = ((const Entete*) base)->champs;
+	
+	AFN A = checked_malloc(sizeof(struct AFN));
+	A->Q = champs[0];
+	A->lenI = champs[1];
+	A->lenF = champs[2];
+	A->lenSigma = champs[3];
+	A->sansEpsilon = champs[4];
+	
+	if(A->Q < 0 || A->lenI < 1 || A->lenSigma < 1 || A->lenSigma > MAX_SYMBOLES) {
+		binaire_invalide(filename, "dimensions de l'automate");
+	}
+	
+	A->Sigma = binaire_section(filename, base, 0, A->lenSigma + 1, 1);
+	A->I = binaire_section(filename, base, 1, A->lenI, sizeof(int));
+	A->F = binaire_section(filename, base, 2, A->lenF, sizeof(int));
+	
+	if(A->Sigma[A->lenSigma] != '\0' || memchr(A->Sigma, EPSILON, A->lenSigma) == NULL) {
+		binaire_invalide(filename, "alphabet");
+	}
+	
+	struct CSR *csr = checked_malloc(sizeof(struct CSR));
+	csr->nbPaires = champs[5];
+	csr->lenDest = champs[6];
+	csr->ligne = binaire_section(filename, base, 3, (int64_t) A->Q + 2, sizeof(int));
+	csr->symbole = binaire_section(filename, base, 4, csr->nbPaires, sizeof(int));
+	csr->debut = binaire_section(filename, base, 5, (int64_t) csr->nbPaires + 1, sizeof(int));
+	csr->dest = binaire_section(filename, base, 6, csr->lenDest, sizeof(int));
+	
+	af_init_dico(A->dico, A->Sigma, A->lenSigma);
+	
+	A->delta = NULL;
+	A->memoire = arena_new_empty();
+	A->csr = csr;
+	
+	if(verifier) {
+		binaire_verifier_afn(filename, A);
+	}
+	
+	A->projection = (void*) base;
+	A->lenProjection = taille;
+	return A;
+}
@@ -0,0 +1,79 @@
+#ifndef BINAIRE_H
+#define BINAIRE_H
+
+#include "afdc.h"
+#include "afn.h"
+
+/**
+ * Format binaire des automates compilés, destiné à être projeté en mémoire (`mmap`) et utilisé sur place.
+ *
+ * Un fichier commence par un en-tête de taille fixe :
+ * - une signature de 8 octets, la version du format, le type de l'automate (AFDC ou AFN figé) ;
+ * - un témoin de boutisme : le format est celui de la machine qui écrit le fichier ;
+ * - la taille totale du fichier et la somme de contrôle de tout ce qui suit l'en-tête ;
+ * - les champs scalaires de l'automate (nombre d'états, état initial, ...) ;
+ * - la position et la longueur de chaque section.
+ *
+ * Les sections suivent l'en-tête, chacune alignée sur 8 octets et complétée par des zéros :
+ * - AFDC : la colonne de chaque octet (l'alphabet), `delta` puis `finals`, tels que dans `struct AFDC` ;
+ * - AFN figé : `Sigma` (avec son '\0'), `I`, `F`, puis les tableaux `ligne`, `symbole`, `debut` et `dest`
+ *   de sa forme CSR.
+ *
+ * Les tableaux d'un automate chargé pointent directement dans la projection, partagée et en lecture seule :
+ * plusieurs processus qui chargent le même fichier partagent une seule copie en cache de pages.
+ */
+
+
+/**
+ * Écrit l'AFDC spécifié dans le fichier `filename` au format binaire.
+ *
+ * Le fichier est écrit sous un nom temporaire puis renommé : les processus qui projettent déjà l'ancien
+ * fichier continuent de l'utiliser sans le voir changer.
+ */
+void binaire_ecrire_afdc(AFDC T, const char *filename);
+
+
+/**
+ * Charge un AFDC depuis le fichier binaire `filename`, sans recopier ses tables ; il doit être libéré
+ * avec `afdc_free(AFDC)`, qui libère aussi la projection.
+ *
+ * L'en-tête, les champs scalaires (dimensions, `q0` et `mort` alignés sur une ligne) et la taille des sections
+ * sont toujours vérifiés. Si `verifier` est non nul, la somme de contrôle puis le contenu des tables le sont
+ * aussi, ce qui lit le fichier en entier : chaque octet doit désigner une colonne, et chaque case de `delta`
+ * le début d'une ligne de la table.
+ *
+ * Remarque:
+ * - Un fichier inaccessible ou invalide termine le programme. Si `verifier` est nul, le contenu des tables
+ *   n'est pas vérifié : il ne faut alors charger que des fichiers sûrs, écrits par `binaire_ecrire_afdc()`,
+ *   sans quoi la simulation peut lire hors de la projection.
+ */
+AFDC binaire_charger_afdc(const char *filename, int verifier);
+
+
+/**
+ * Écrit l'AFN spécifié dans le fichier `filename` au format binaire ; l'AFN est d'abord figé s'il ne l'est pas.
+ *
+ * Voir aussi:
+ * - `binaire_ecrire_afdc(AFDC, const char*)`
+ */
+void binaire_ecrire_afn(AFN A, const char *filename);
+
+
+/**
+ * Charge un AFN figé depuis le fichier binaire `filename`, sans recopier ses tableaux ; il doit être libéré
+ * avec `afn_free(AFN)`, qui libère aussi la projection.
+ *
+ * L'AFN chargé n'a que sa forme figée (`delta` vaut `NULL`) : il peut être simulé, déterminisé ou inversé,
+ * mais pas combiné à d'autres AFN, affiché ou dessiné.
+ *
+ * Si `verifier` est non nul, le contenu des tableaux est vérifié après la somme de contrôle : les états
+ * initiaux, finaux et d'arrivée doivent être compris entre `0` et `Q`, les lignes et les listes de la forme
+ * CSR croissantes et bornées par `nbPaires` et `lenDest`, les symboles d'une ligne triés, et chaque liste
+ * terminée par `INVALID_STATE`. Sinon, seuls l'en-tête, l'alphabet et la taille des sections le sont.
+ *
+ * Voir aussi:
+ * - `binaire_charger_afdc(const char*, int)`
+ */
+AFN binaire_charger_afn(const char *filename, int verifier);
+
+#endif // BINAIRE_H
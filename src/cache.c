@@ -0,0 +1,401 @@
+#include "cache.h"
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "compregex.h"
+#include "util/misc.h"
+
+/**
+ * Le nombre de seaux initial des tables d'un cache.
+ */
+#define CACHE_SEAUX_MIN 16
+
+
+/**
+ * Renvoie une copie du motif spécifié privée de ses blancs, que l'analyseur lexical ignore.
+ */
+static char* cache_normaliser(const char *motif) {
+	char *cle = checked_malloc(strlen(motif) + 1);
+	size_t n = 0;
+	
+	for(const char *c = motif; *c != '\0'; ++c) {
+		if(!isspace((unsigned char) *c)) {
+			cle[n++] = *c;
+		}
+	}
+	
+	cle[n] = '\0';
+	return cle;
+}
+
+
+/**
+ * Calcul l'empreinte d'un motif normalisé (FNV-1a sur ses caractères).
+ */
+static size_t cache_hash_cle(const char *cle) {
+	size_t h = (size_t) 14695981039346656037ULL;
+	
+	for(const char *c = cle; *c != '\0'; ++c) {
+		h ^= (size_t) (unsigned char) *c;
+		h *= (size_t) 1099511628211ULL;
+	}
+	
+	return h;
+}
+
+
+/**
+ * Calcul l'empreinte d'un AFN à partir de son adresse, dont les bits de poids faible sont toujours nuls.
+ */
+static size_t cache_hash_afn(AFN A) {
+	size_t h = (size_t) 14695981039346656037ULL;
+	h ^= (size_t) ((uintptr_t) A >> 4);
+	h *= (size_t) 1099511628211ULL;
+	
+	return h ^ (h >> 32);
+}
+
+
+/**
+ * Renvoie l'entrée présente du motif normalisé `cle` d'empreinte `h`, ou `NULL`.
+ */
+static struct EntreeCache* cache_chercher(Cache C, const char *cle, size_t h) {
+	struct EntreeCache *E = C->seauxCle[h & (C->nbSeaux - 1)];
+	
+	while(E != NULL && (E->empreinte != h || strcmp(E->cle, cle) != 0)) {
+		E = E->suivanteCle;
+	}
+	
+	return E;
+}
+
+
+/**
+ * Double le nombre de seaux des deux tables et y replace toutes les entrées.
+ */
+static void cache_agrandir(Cache C) {
+	size_t nbSeaux = C->nbSeaux * 2;
+	size_t mask = nbSeaux - 1;
+	
+	struct EntreeCache **seauxCle = checked_malloc(nbSeaux * sizeof(struct EntreeCache*));
+	struct EntreeCache **seauxAFN = checked_malloc(nbSeaux * sizeof(struct EntreeCache*));
+	memset(seauxCle, 0, nbSeaux * sizeof(struct EntreeCache*));
+	memset(seauxAFN, 0, nbSeaux * sizeof(struct EntreeCache*));
+	
+	// les entrées présentes sont exactement celles de la liste d'utilisation
+	for(struct EntreeCache *E = C->premiere; E != NULL; E = E->suivante) {
+		size_t i = E->empreinte & mask;
+		E->suivanteCle = seauxCle[i];
+		seauxCle[i] = E;
+	}
+	
+	for(size_t k = 0; k < C->nbSeaux; ++k) {
+		struct EntreeCache *E = C->seauxAFN[k];
+		
+		while(E != NULL) {
+			struct EntreeCache *suivante = E->suivanteAFN;
+			size_t i = cache_hash_afn(E->A) & mask;
+			E->suivanteAFN = seauxAFN[i];
+			seauxAFN[i] = E;
+			E = suivante;
+		}
+	}
+	
+	free(C->seauxCle);
+	free(C->seauxAFN);
+	C->seauxCle = seauxCle;
+	C->seauxAFN = seauxAFN;
+	C->nbSeaux = nbSeaux;
+}
+
+
+/**
+ * Retire l'entrée spécifiée de la liste d'utilisation.
+ */
+static void cache_detacher(Cache C, struct EntreeCache *E) {
+	if(E->precedente != NULL) {
+		E->precedente->suivante = E->suivante;
+	}
+	else {
+		C->premiere = E->suivante;
+	}
+	
+	if(E->suivante != NULL) {
+		E->suivante->precedente = E->precedente;
+	}
+	else {
+		C->derniere = E->precedente;
+	}
+	
+	E->precedente = NULL;
+	E->suivante = NULL;
+}
+
+
+/**
+ * Place l'entrée spécifiée, hors de la liste d'utilisation, en tête de celle-ci.
+ */
+static void cache_placer_en_tete(Cache C, struct EntreeCache *E) {
+	E->precedente = NULL;
+	E->suivante = C->premiere;
+	
+	if(C->premiere != NULL) {
+		C->premiere->precedente = E;
+	}
+	else {
+		C->derniere = E;
+	}
+	
+	C->premiere = E;
+}
+
+
+/**
+ * Retire l'entrée spécifiée de la table indexée par AFN, puis la libère avec son AFN.
+ */
+static void cache_detruire(Cache C, struct EntreeCache *E) {
+	struct EntreeCache **p = &C->seauxAFN[cache_hash_afn(E->A) & (C->nbSeaux - 1)];
+	
+	while(*p != E) {
+		p = &(*p)->suivanteAFN;
+	}
+	
+	*p = E->suivanteAFN;
+	--(C->nbVivantes);
+	
+	afn_free(E->A);
+	free(E->cle);
+	free(E);
+}
+
+
+/**
+ * Évince l'entrée présente spécifiée du cache ; elle n'est libérée que si elle n'est plus référencée.
+ */
+static void cache_evincer(Cache C, struct EntreeCache *E) {
+	struct EntreeCache **p = &C->seauxCle[E->empreinte & (C->nbSeaux - 1)];
+	
+	while(*p != E) {
+		p = &(*p)->suivanteCle;
+	}
+	
+	*p = E->suivanteCle;
+	cache_detacher(C, E);
+	
+	E->presente = 0;
+	--(C->stats.entrees);
+	C->stats.octets -= E->taille;
+	++(C->stats.evictions);
+	
+	if(E->references == 0) {
+		cache_detruire(C, E);
+	}
+}
+
+
+/**
+ * Évince les entrées les moins récemment utilisées jusqu'à ce que le cache respecte sa capacité.
+ */
+static void cache_reduire(Cache C) {
+	while(C->derniere != NULL
+		&& ((C->maxEntrees > 0 && C->stats.entrees > C->maxEntrees) || (C->maxOctets > 0 && C->stats.octets > C->maxOctets))) {
+		cache_evincer(C, C->derniere);
+	}
+}
+
+
+/**
+ * Initialise et renvoie un nouveau cache vide.
+ *
+ * Paramètres:
+ * - maxEntrees: le nombre maximal d'entrées conservées, ou `0` pour ne pas le limiter
+ * - maxOctets : la taille totale maximale des entrées conservées, ou `0` pour ne pas la limiter
+ */
+Cache cache_init(size_t maxEntrees, size_t maxOctets) {
+	Cache C = checked_malloc(sizeof(struct Cache));
+	C->maxEntrees = maxEntrees;
+	C->maxOctets = maxOctets;
+	
+	C->nbSeaux = CACHE_SEAUX_MIN;
+	C->seauxCle = checked_malloc(C->nbSeaux * sizeof(struct EntreeCache*));
+	C->seauxAFN = checked_malloc(C->nbSeaux * sizeof(struct EntreeCache*));
+	memset(C->seauxCle, 0, C->nbSeaux * sizeof(struct EntreeCache*));
+	memset(C->seauxAFN, 0, C->nbSeaux * sizeof(struct EntreeCache*));
+	C->nbVivantes = 0;
+	
+	C->premiere = NULL;
+	C->derniere = NULL;
+	memset(&C->stats, 0, sizeof(CacheStats));
+	
+	pthread_mutex_init(&C->verrou, NULL);
+	
+	return C;
+}
+
+
+/**
+ * Renvoie l'AFN de l'expression régulière spécifiée, compilé par `compile()` ou repris du cache, et en prend
+ * une référence ; deux motifs qui ne diffèrent que par leurs blancs partagent le même AFN.
+ *
+ * L'AFN renvoyé est figé et partagé : il ne doit être ni modifié ni libéré, mais rendu par `cache_rendre()`.
+ * Il reste valide jusque-là, même s'il est évincé du cache entre-temps.
+ *
+ * Remarque:
+ * - Une erreur lexicale ou syntaxique termine le programme, comme pour `compile(const char*)`.
+ */
+AFN cache_compiler(Cache C, const char *motif) {
+	check_param("motif", motif != NULL);
+	
+	char *cle = cache_normaliser(motif);
+	size_t h = cache_hash_cle(cle);
+	
+	pthread_mutex_lock(&C->verrou);
+	
+	struct EntreeCache *E = cache_chercher(C, cle, h);
+	
+	if(E != NULL) {
+		++(C->stats.succes);
+	}
+	else {
+		++(C->stats.echecs);
+		
+		// la compilation a lieu hors du verrou, afin de ne pas bloquer les autres threads
+		pthread_mutex_unlock(&C->verrou);
+		
+		AFN A = compile(motif);
+		afn_figer(A);
+		
+		pthread_mutex_lock(&C->verrou);
+		
+		// un autre thread a pu compiler le même motif entre-temps
+		E = cache_chercher(C, cle, h);
+		
+		if(E != NULL) {
+			afn_free(A);
+		}
+		else {
+			if(C->nbVivantes + 1 > C->nbSeaux) {
+				cache_agrandir(C);
+			}
+			
+			E = checked_malloc(sizeof(struct EntreeCache));
+			E->cle = cle;
+			E->empreinte = h;
+			E->A = A;
+			E->taille = sizeof(struct EntreeCache) + strlen(cle) + 1 + afn_taille(A);
+			E->references = 0;
+			E->presente = 1;
+			cle = NULL;
+			
+			size_t i = h & (C->nbSeaux - 1);
+			E->suivanteCle = C->seauxCle[i];
+			C->seauxCle[i] = E;
+			
+			i = cache_hash_afn(A) & (C->nbSeaux - 1);
+			E->suivanteAFN = C->seauxAFN[i];
+			C->seauxAFN[i] = E;
+			++(C->nbVivantes);
+			
+			cache_placer_en_tete(C, E);
+			++(C->stats.entrees);
+			C->stats.octets += E->taille;
+		}
+	}
+	
+	// `E` devient la plus récemment utilisée ; si `cache_reduire()` l'évince, elle reste valide grâce à sa référence
+	if(E->presente && E != C->premiere) {
+		cache_detacher(C, E);
+		cache_placer_en_tete(C, E);
+	}
+	
+	++(E->references);
+	AFN A = E->A;
+	
+	cache_reduire(C);
+	
+	pthread_mutex_unlock(&C->verrou);
+	
+	free(cle);
+	return A;
+}
+
+
+/**
+ * Rend une référence obtenue par `cache_compiler()` ; l'AFN est libéré s'il a été évincé et n'est plus référencé.
+ */
+void cache_rendre(Cache C, AFN A) {
+	pthread_mutex_lock(&C->verrou);
+	
+	struct EntreeCache *E = C->seauxAFN[cache_hash_afn(A) & (C->nbSeaux - 1)];
+	
+	while(E != NULL && E->A != A) {
+		E = E->suivanteAFN;
+	}
+	
+	check_param("A", E != NULL && E->references > 0);
+	
+	--(E->references);
+	
+	if(E->references == 0 && !E->presente) {
+		cache_detruire(C, E);
+	}
+	
+	pthread_mutex_unlock(&C->verrou);
+}
+
+
+/**
+ * Renvoie une copie des compteurs actuels du cache.
+ */
+CacheStats cache_stats(Cache C) {
+	pthread_mutex_lock(&C->verrou);
+	CacheStats S = C->stats;
+	pthread_mutex_unlock(&C->verrou);
+	
+	return S;
+}
+
+
+/**
+ * Affiche les compteurs actuels du cache dans le flux spécifié.
+ */
+void cache_afficher_stats(Cache C, FILE *f) {
+	CacheStats S = cache_stats(C);
+	unsigned long long total = S.succes + S.echecs;
+	
+	fprintf(f, "succès / échecs : %llu / %llu (%.1f %% de succès)\n",
+		S.succes, S.echecs, (total > 0) ? 100.0 * S.succes / total : 0.0);
+	fprintf(f, "évictions       : %llu\n", S.evictions);
+	fprintf(f, "entrées         : %zu (%zu octets)\n", S.entrees, S.octets);
+}
+
+
+/**
+ * Libère les ressources allouées à un cache.
+ *
+ * Remarque:
+ * - Toutes les références obtenues par `cache_compiler()` doivent avoir été rendues.
+ */
+void cache_free(Cache C) {
+	// toutes les entrées, présentes ou évincées mais encore référencées, sont dans la table indexée par AFN
+	for(size_t k = 0; k < C->nbSeaux; ++k) {
+		struct EntreeCache *E = C->seauxAFN[k];
+		
+		while(E != NULL) {
+			struct EntreeCache *suivante = E->suivanteAFN;
+			afn_free(E->A);
+			free(E->cle);
+			free(E);
+			E = suivante;
+		}
+	}
+	
+	free(C->seauxCle);
+	free(C->seauxAFN);
+	pthread_mutex_destroy(&C->verrou);
+	free(C);
+	C = NULL;
+}
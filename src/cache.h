@@ -0,0 +1,171 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "afn.h"
+
+/**
+ * Représente un motif compilé conservé par un cache.
+ */
+struct EntreeCache {
+	/**
+	 * Le motif normalisé (c.-à-d. privé de ses blancs), terminé par '\0', et son empreinte.
+	 */
+	char *cle;
+	size_t empreinte;
+	
+	/**
+	 * L'AFN produit par `compile()` pour ce motif, figé ; il est partagé et ne doit pas être modifié.
+	 */
+	AFN A;
+	
+	/**
+	 * La taille de l'entrée en octets, AFN compris.
+	 */
+	size_t taille;
+	
+	/**
+	 * Le nombre de références obtenues par `cache_compiler()` et pas encore rendues par `cache_rendre()`.
+	 */
+	int references;
+	
+	/**
+	 * `1` si l'entrée est dans le cache, `0` si elle en a été évincée mais est encore référencée.
+	 */
+	int presente;
+	
+	/**
+	 * Les entrées voisines dans l'ordre d'utilisation : `precedente` a été utilisée plus récemment.
+	 */
+	struct EntreeCache *precedente;
+	struct EntreeCache *suivante;
+	
+	/**
+	 * L'entrée suivante du même seau, dans la table indexée par motif et dans celle indexée par AFN.
+	 */
+	struct EntreeCache *suivanteCle;
+	struct EntreeCache *suivanteAFN;
+};
+
+
+/**
+ * Représente les compteurs d'un cache.
+ */
+typedef struct {
+	/**
+	 * Le nombre d'appels à `cache_compiler()` ayant trouvé le motif dans le cache, et de ceux l'ayant compilé.
+	 */
+	unsigned long long succes;
+	unsigned long long echecs;
+	
+	/**
+	 * Le nombre d'entrées évincées pour respecter la capacité du cache.
+	 */
+	unsigned long long evictions;
+	
+	/**
+	 * Le nombre d'entrées dans le cache, et leur taille totale en octets.
+	 */
+	size_t entrees;
+	size_t octets;
+} CacheStats;
+
+
+/**
+ * Représente un cache LRU d'expressions régulières compilées par `compile()`, indexé par leur texte normalisé.
+ *
+ * Le cache peut être utilisé simultanément par plusieurs threads.
+ */
+struct Cache {
+	/**
+	 * La capacité du cache, en nombre d'entrées et en octets ; `0` signifie aucune limite.
+	 */
+	size_t maxEntrees;
+	size_t maxOctets;
+	
+	/**
+	 * Les seaux de la table indexée par motif (entrées présentes) et de celle indexée par AFN (toutes les entrées
+	 * encore présentes ou référencées) ; `nbSeaux` est une puissance de deux.
+	 */
+	struct EntreeCache **seauxCle;
+	struct EntreeCache **seauxAFN;
+	size_t nbSeaux;
+	
+	/**
+	 * Le nombre d'entrées présentes ou référencées.
+	 */
+	size_t nbVivantes;
+	
+	/**
+	 * Les entrées présentes, de la plus récemment utilisée (`premiere`) à la moins récemment utilisée (`derniere`).
+	 */
+	struct EntreeCache *premiere;
+	struct EntreeCache *derniere;
+	
+	/**
+	 * Les compteurs du cache.
+	 */
+	CacheStats stats;
+	
+	/**
+	 * Protège tous les champs précédents.
+	 */
+	pthread_mutex_t verrou;
+};
+
+typedef struct Cache* Cache;
+
+
+/**
+ * Initialise et renvoie un nouveau cache vide.
+ *
+ * Paramètres:
+ * - maxEntrees: le nombre maximal d'entrées conservées, ou `0` pour ne pas le limiter
+ * - maxOctets : la taille totale maximale des entrées conservées, ou `0` pour ne pas la limiter
+ */
+Cache cache_init(size_t maxEntrees, size_t maxOctets);
+
+
+/**
+ * Renvoie l'AFN de l'expression régulière spécifiée, compilé par `compile()` ou repris du cache, et en prend
+ * une référence ; deux motifs qui ne diffèrent que par leurs blancs partagent le même AFN.
+ *
+ * L'AFN renvoyé est figé et partagé : il ne doit être ni modifié ni libéré, mais rendu par `cache_rendre()`.
+ * Il reste valide jusque-là, même s'il est évincé du cache entre-temps.
+ *
+ * Remarque:
+ * - Une erreur lexicale ou syntaxique termine le programme, comme pour `compile(const char*)`.
+ */
+AFN cache_compiler(Cache C, const char *motif);
+
+
+/**
+ * Rend une référence obtenue par `cache_compiler()` ; l'AFN est libéré s'il a été évincé et n'est plus référencé.
+ */
+void cache_rendre(Cache C, AFN A);
+
+
+/**
+ * Renvoie une copie des compteurs actuels du cache.
+ */
+CacheStats cache_stats(Cache C);
+
+
+/**
+ * Affiche les compteurs actuels du cache dans le flux spécifié.
+ */
+void cache_afficher_stats(Cache C, FILE *f);
+
+
+/**
+ * Libère les ressources allouées à un cache.
+ *
+ * Remarque:
+ * - Toutes les références obtenues par `cache_compiler()` doivent avoir été rendues.
+ */
+void cache_free(Cache C);
+
+#endif // CACHE_H
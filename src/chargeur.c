@@ -0,0 +1,489 @@
+#include "chargeur.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "util/misc.h"
+#include "util/tbuf.h"
+
+/**
+ * La taille minimale d'un morceau de la section des transitions lu par un thread.
+ */
+#define CHARGEUR_MORCEAU_MIN (1 << 20)
+
+/**
+ * Représente le fichier lu, projeté en mémoire de `debut` (inclus) à `fin` (exclue).
+ */
+typedef struct {
+	const char *nom;
+	const char *debut;
+	const char *fin;
+} Fichier;
+
+
+/**
+ * Représente un morceau de la section des transitions, lu par un thread dans son propre tampon.
+ */
+typedef struct {
+	const char *debut;
+	const char *fin;
+	
+	/**
+	 * Le plus grand état et le `dico` de l'automate, pour vérifier chaque transition.
+	 */
+	int Q;
+	const int *dico;
+	
+	tbuf T;
+	
+	/**
+	 * La position et le message de la première erreur du morceau, ou `NULL`.
+	 */
+	const char *erreur;
+	const char *message;
+} Morceau;
+
+
+/**
+ * Affiche l'erreur `message` survenue à la position spécifiée du fichier, et termine le programme.
+ *
+ * Le numéro de ligne n'est calculé qu'ici, en comptant les fins de ligne qui précèdent `position` ;
+ * `message` peut afficher le caractère fautif avec `%c`.
+ */
+static void chargeur_erreur(const Fichier *F, const char *position, const char *message) {
+	long ligne = 1;
+	const char *debutLigne = F->debut;
+	
+	for(const char *p = F->debut; p != NULL && (p = memchr(p, '\n', position - p)) != NULL; ++p) {
+		++ligne;
+		debutLigne = p + 1;
+	}
+	
+	fprintf(stderr, "%s:%li:%li: ", F->nom, ligne, (long) (position - debutLigne));
+	fprintf(stderr, message, (position != F->fin) ? *position : '\0');
+	fprintf(stderr, "\n");
+	exit(1);
+}
+
+
+static inline int chiffre(char c) {
+	return (unsigned) (c - '0') < 10;
+}
+
+
+static inline int espace(char c) {
+	return c == ' ' || (unsigned) (c - '\t') < 5;
+}
+
+
+/**
+ * Lit le nombre entier positif qui commence en `*p`, suivi d'une espace ou de la fin du fichier ; `*p` pointe
+ * ensuite sur cette espace.
+ *
+ * Renvoie `NULL`, ou le message d'erreur si le nombre est malformé, `*p` pointant alors sur le caractère fautif.
+ */
+static inline const char* scanner_entier(const char **p, const char *fin, int *val) {
+	const char *s = *p;
+	
+	if(s == fin || !chiffre(*s)) {
+		return "nombre entier malformé";
+	}
+	
+	int v = 0;
+	do {
+		if(v > (INT_MAX - 9) / 10) {
+			*p = s;
+			return "nombre entier malformé: trop grand";
+		}
+		
+		v = v * 10 + (*s++ - '0');
+	}
+	while(s != fin && chiffre(*s));
+	
+	*p = s;
+	if(s != fin && !espace(*s)) {
+		return "nombre entier malformé: caractère inattendu '%c'";
+	}
+	
+	*val = v;
+	return NULL;
+}
+
+
+/**
+ * Lit le nombre entier positif qui commence en `*p`, terminant le programme s'il est malformé.
+ */
+static int lire_entier(const Fichier *F, const char **p) {
+	if(*p == F->fin) {
+		fprintf(stderr, "%s: nombre entier attendu, fin du fichier\n", F->nom);
+		exit(1);
+	}
+	
+	int val;
+	const char *message = scanner_entier(p, F->fin, &val);
+	if(message != NULL) {
+		chargeur_erreur(F, *p, message);
+	}
+	
+	return val;
+}
+
+
+/**
+ * Passe la fin de ligne en `*p`, terminant le programme si la ligne contient d'autres caractères.
+ */
+static void lire_fin_de_ligne(const Fichier *F, const char **p, const char *message) {
+	if(*p == F->fin) {
+		return;
+	}
+	
+	if(**p != '\n') {
+		chargeur_erreur(F, *p, message);
+	}
+	
+	++(*p);
+}
+
+
+/**
+ * Lit une ligne contenant la taille d'un ensemble d'états, puis la ligne contenant ses éléments.
+ */
+static int* lire_ensemble(const Fichier *F, const char **p, int *outLen, int Q) {
+	int len = lire_entier(F, p);
+	lire_fin_de_ligne(F, p, "nombre entier malformé: caractères en surplus");
+	
+	// `checked_malloc()` refuse une taille nulle
+	int *set = checked_malloc((len + 1) * sizeof(int));
+	
+	for(int i = 0; i < len; ++i) {
+		if(i > 0 && *p != F->fin) {
+			// une espace sépare deux éléments, comme pour `fparse_int_set()`
+			++(*p);
+		}
+		
+		const char *debut = *p;
+		set[i] = lire_entier(F, p);
+		
+		if(set[i] > Q) {
+			chargeur_erreur(F, debut, "q > Q");
+		}
+	}
+	
+	if(*p != F->fin && **p != '\n') {
+		chargeur_erreur(F, *p, "l'ensemble est plus grand que la taille spécifiée par la ligne précédente");
+	}
+	
+	lire_fin_de_ligne(F, p, "");
+	
+	*outLen = len;
+	return set;
+}
+
+
+/**
+ * Lit une ligne contenant l'alphabet ; la chaîne renvoyée doit être libérée avec `free()`.
+ */
+static char* lire_Sigma(const Fichier *F, const char **p, int *outLen) {
+	if(*p == F->fin) {
+		chargeur_erreur(F, *p, "fin du fichier, alphabet attendu");
+	}
+	
+	const char *fin = memchr(*p, '\n', F->fin - *p);
+	if(fin == NULL) {
+		fin = F->fin;
+	}
+	
+	int len = fin - *p;
+	char *Sigma = checked_malloc(len + 1);
+	memcpy(Sigma, *p, len);
+	Sigma[len] = '\0';
+	
+	*p = (fin == F->fin) ? fin : (fin + 1);
+	*outLen = len;
+	return Sigma;
+}
+
+
+/**
+ * Lit les transitions `q1 τ q2` d'un morceau, une par ligne, dans le tampon du morceau.
+ *
+ * Comme pour `fparse_transition()`, la fin d'une ligne après le second état est ignorée.
+ */
+static void* chargeur_morceau(void *arg) {
+	Morceau *M = arg;
+	const char *p = M->debut;
+	const char *fin = M->fin;
+	
+	while(p != fin) {
+		const char *ligne = p;
+		int q1, q2;
+		char c;
+		
+		if((M->message = scanner_entier(&p, fin, &q1)) != NULL) {
+			break;
+		}
+		
+		if(q1 > M->Q) {
+			p = ligne;
+			M->message = "q > Q";
+			break;
+		}
+		
+		// une espace, le symbole, une espace puis le second état
+		if(p == fin || *p == '\n' || ++p == fin || *p == '\n') {
+			M->message = "transition malformée: symbole attendu";
+			break;
+		}
+		
+		c = *p++;
+		if(c < ASCII_FIRST || c > ASCII_LAST || M->dico[c - ASCII_FIRST] == -1) {
+			--p;
+			M->message = "transition malformée: '%c' n'appartient pas à l'alphabet";
+			break;
+		}
+		
+		if(p == fin || !espace(*p) || *p == '\n' || ++p == fin) {
+			M->message = "transition malformée: un second état est attendu";
+			break;
+		}
+		
+		const char *etat = p;
+		if((M->message = scanner_entier(&p, fin, &q2)) != NULL) {
+			break;
+		}
+		
+		if(q2 > M->Q) {
+			p = etat;
+			M->message = "q > Q";
+			break;
+		}
+		
+		tbuf_push(&M->T, q1, c, q2);
+		
+		p = memchr(p, '\n', fin - p);
+		p = (p == NULL) ? fin : (p + 1);
+	}
+	
+	M->erreur = (M->message != NULL) ? p : NULL;
+	return NULL;
+}
+
+
+/**
+ * Lit la section des transitions, de `p` à la fin du fichier, en `nbThreads` morceaux, et renvoie leurs transitions
+ * dans l'ordre du fichier.
+ */
+static tbuf chargeur_transitions(const Fichier *F, const char *p, int nbThreads, int Q, const int *dico) {
+	size_t n = F->fin - p;
+	if(nbThreads > 1 && n / CHARGEUR_MORCEAU_MIN < (size_t) nbThreads) {
+		nbThreads = (int) (n / CHARGEUR_MORCEAU_MIN);
+	}
+	
+	if(nbThreads < 1) {
+		nbThreads = 1;
+	}
+	
+	Morceau *M = checked_malloc(nbThreads * sizeof(Morceau));
+	pthread_t *threads = checked_malloc(nbThreads * sizeof(pthread_t));
+	int *lance = checked_malloc(nbThreads * sizeof(int));
+	
+	// chaque morceau commence au début d'une ligne
+	const char *debut = p;
+	for(int k = 0; k < nbThreads; ++k) {
+		const char *fin = (k == nbThreads - 1) ? F->fin : (p + (k + 1) * (n / nbThreads));
+		if(fin < debut) {
+			fin = debut;
+		}
+		
+		const char *nl = (fin == F->fin) ? NULL : memchr(fin, '\n', F->fin - fin);
+		fin = (nl == NULL) ? F->fin : (nl + 1);
+		
+		M[k].debut = debut;
+		M[k].fin = fin;
+		M[k].Q = Q;
+		M[k].dico = dico;
+		M[k].T = tbuf_new_empty();
+		M[k].erreur = NULL;
+		M[k].message = NULL;
+		
+		// une transition occupe au moins 6 octets : "q τ q\n"
+		tbuf_reserve(&M[k].T, (fin - debut) / 6 + 1);
+		debut = fin;
+	}
+	
+	// le premier morceau est lu par le thread appelant ; un morceau dont le thread n'a pas pu être créé aussi
+	for(int k = 1; k < nbThreads; ++k) {
+		lance[k] = pthread_create(&threads[k], NULL, chargeur_morceau, &M[k]) == 0;
+	}
+	
+	chargeur_morceau(&M[0]);
+	
+	for(int k = 1; k < nbThreads; ++k) {
+		if(lance[k]) {
+			pthread_join(threads[k], NULL);
+		}
+		else {
+			chargeur_morceau(&M[k]);
+		}
+	}
+	
+	// la première erreur du fichier est signalée
+	for(int k = 0; k < nbThreads; ++k) {
+		if(M[k].erreur != NULL) {
+			chargeur_erreur(F, M[k].erreur, M[k].message);
+		}
+	}
+	
+	// concaténation des tampons dans celui du premier morceau
+	tbuf T = M[0].T;
+	for(int k = 1; k < nbThreads; ++k) {
+		tbuf_reserve(&T, M[k].T.len);
+		memcpy(&T.buf[T.len], M[k].T.buf, M[k].T.len * sizeof(transition));
+		T.len += M[k].T.len;
+		tbuf_free(&M[k].T);
+	}
+	
+	free(M);
+	free(threads);
+	free(lance);
+	return T;
+}
+
+
+/**
+ * Projette en mémoire le fichier `resources/filename`.
+ */
+static Fichier chargeur_ouvrir(const char *filename) {
+	char *rpath = concat("resources/", filename);
+	int fd = open(rpath, O_RDONLY);
+	free(rpath);
+	
+	struct stat st;
+	if(fd == -1 || fstat(fd, &st) != 0) {
+		fprintf(stderr, "fichier inaccessible: %s\n", filename);
+		exit(1);
+	}
+	
+	Fichier F = { filename, NULL, NULL };
+	
+	if(st.st_size > 0) {
+		void *projection = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(projection == MAP_FAILED) {
+			fprintf(stderr, "fichier inaccessible: %s\n", filename);
+			exit(1);
+		}
+		
+		// le fichier est lu une seule fois, du début à la fin
+		madvise(projection, st.st_size, MADV_SEQUENTIAL);
+		
+		F.debut = projection;
+		F.fin = F.debut + st.st_size;
+	}
+	
+	close(fd);
+	return F;
+}
+
+
+static void chargeur_fermer(Fichier *F) {
+	if(F->debut != NULL) {
+		munmap((void*) F->debut, F->fin - F->debut);
+	}
+}
+
+
+/**
+ * Initialise et renvoie un nouvel AFN à partir d'un fichier `filename` du même format que pour `afn_finit(const char*)`,
+ * lui aussi cherché dans `resources/`.
+ *
+ * Le fichier est projeté en mémoire et lu d'un seul tenant, sans découpage en lignes ; la section des transitions
+ * est découpée en `nbThreads` morceaux lus en parallèle s'il est assez grand (1 Mio par morceau au moins).
+ *
+ * Remarque:
+ * - Les erreurs de format sont signalées par les mêmes messages que `afn_finit(const char*)`, précédés du fichier,
+ *   de la ligne et de la colonne du caractère fautif, comptée à partir de 0 ; `afn_finit()` désigne parfois le
+ *   caractère suivant (second état manquant, éléments en surplus) ou une colonne sans signification.
+ * - Un symbole hors de l'alphabet ou un état supérieur à `Q` dans une transition sont eux aussi situés dans le
+ *   fichier, là où `afn_finit()` les signale sans position par `afn_ajouter_transitions()` ou `check_param()`.
+ */
+AFN chargeur_afn(const char *filename, int nbThreads) {
+	Fichier F = chargeur_ouvrir(filename);
+	const char *p = F.debut;
+	
+	int Q = lire_entier(&F, &p);
+	lire_fin_de_ligne(&F, &p, "nombre entier malformé: caractères en surplus");
+	
+	int lenI;
+	int *I = lire_ensemble(&F, &p, &lenI, Q);
+	
+	int lenF;
+	int *Fin = lire_ensemble(&F, &p, &lenF, Q);
+	
+	int lenSigma;
+	char *Sigma = lire_Sigma(&F, &p, &lenSigma);
+	
+	// `afn_init()` ajoute EPSILON à l'alphabet
+	AFN A = afn_init(Q, lenI, I, lenF, Fin, Sigma);
+	free(I);
+	free(Fin);
+	free(Sigma);
+	
+	tbuf T = chargeur_transitions(&F, p, nbThreads, Q, A->dico);
+	afn_ajouter_transitions(A, &T);
+	tbuf_free(&T);
+	
+	chargeur_fermer(&F);
+	return A;
+}
+
+
+/**
+ * Initialise et renvoie un nouvel AFD à partir d'un fichier `filename` du même format que pour `afd_finit(char*)`,
+ * lui aussi cherché dans `resources/`.
+ *
+ * Voir aussi:
+ * - `chargeur_afn(const char*, int)`
+ */
+AFD chargeur_afd(const char *filename, int nbThreads) {
+	Fichier F = chargeur_ouvrir(filename);
+	const char *p = F.debut;
+	
+	int Q = lire_entier(&F, &p);
+	lire_fin_de_ligne(&F, &p, "nombre entier malformé: caractères en surplus");
+	
+	const char *etat = p;
+	int q0 = lire_entier(&F, &p);
+	lire_fin_de_ligne(&F, &p, "nombre entier malformé: caractères en surplus");
+	
+	if(q0 > Q) {
+		chargeur_erreur(&F, etat, "q > Q");
+	}
+	
+	int lenF;
+	int *Fin = lire_ensemble(&F, &p, &lenF, Q);
+	
+	int lenSigma;
+	char *Sigma = lire_Sigma(&F, &p, &lenSigma);
+	
+	AFD A = afd_init(Q, q0, lenF, Fin, Sigma);
+	free(Fin);
+	free(Sigma);
+	
+	tbuf T = chargeur_transitions(&F, p, nbThreads, Q, A->dico);
+	
+	// les transitions sont appliquées dans l'ordre du fichier : la dernière d'une paire (q, τ) l'emporte
+	for(size_t i = 0; i < T.len; ++i) {
+		A->delta[T.buf[i].q1][A->dico[T.buf[i].c - ASCII_FIRST]] = T.buf[i].q2;
+	}
+	
+	tbuf_free(&T);
+	chargeur_fermer(&F);
+	return A;
+}
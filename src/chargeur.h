@@ -0,0 +1,33 @@
+#ifndef CHARGEUR_H
+#define CHARGEUR_H
+
+#include "afd.h"
+#include "afn.h"
+
+/**
+ * Initialise et renvoie un nouvel AFN à partir d'un fichier `filename` du même format que pour `afn_finit(const char*)`,
+ * lui aussi cherché dans `resources/`.
+ *
+ * Le fichier est projeté en mémoire et lu d'un seul tenant, sans découpage en lignes ; la section des transitions
+ * est découpée en `nbThreads` morceaux lus en parallèle s'il est assez grand (1 Mio par morceau au moins).
+ *
+ * Remarque:
+ * - Les erreurs de format sont signalées par les mêmes messages que `afn_finit(const char*)`, précédés du fichier,
+ *   de la ligne et de la colonne du caractère fautif, comptée à partir de 0 ; `afn_finit()` désigne parfois le
+ *   caractère suivant (second état manquant, éléments en surplus) ou une colonne sans signification.
+ * - Un symbole hors de l'alphabet ou un état supérieur à `Q` dans une transition sont eux aussi situés dans le
+ *   fichier, là où `afn_finit()` les signale sans position par `afn_ajouter_transitions()` ou `check_param()`.
+ */
+AFN chargeur_afn(const char *filename, int nbThreads);
+
+
+/**
+ * Initialise et renvoie un nouvel AFD à partir d'un fichier `filename` du même format que pour `afd_finit(char*)`,
+ * lui aussi cherché dans `resources/`.
+ *
+ * Voir aussi:
+ * - `chargeur_afn(const char*, int)`
+ */
+AFD chargeur_afd(const char *filename, int nbThreads);
+
+#endif // CHARGEUR_H
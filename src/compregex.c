@@ -5,8 +5,19 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "ast.h"
+#include "util/stack.h"
+#include "util/tbuf.h"
 #include "util/vstack.h"
 #include "util/misc.h"
+#include "util/stats.h"
+
+/**
+ * Le code de sortie du programme en cas d'erreur lexicale ou syntaxique dans une expression régulière ;
+ * vaut `1` par défaut.
+ */
+int compregex_code_erreur = 1;
+
 
 /**
  * Représente le nom d'une unité lexicale.
@@ -149,7 +160,7 @@ Lexeme* analyse_lexicale(const char *s, size_t *outLen) {
 		else if(!isspace(*s)) {
 			eprintln(str, i, 1);
 			fprintf(stderr, "erreur lexicale: lexème inconnu: '%c'\n", *s);
-			exit(1);
+			exit(compregex_code_erreur);
 		}
 		
 		++s;
@@ -169,10 +180,10 @@ Lexeme* analyse_lexicale(const char *s, size_t *outLen) {
  * - lexemes: un tableau de lexèmes
  * - n      : la taille de ce tableau
  * - i      : un pointeur vers l'indice du lexème courant (c.-à-d. celui en train d'être analysé syntaxiquement)
- * - stack  : un pointeur vers une pile d'AFN
+ * - actions: les actions à exécuter à chaque règle reconnue
  * - s      : la chaîne de caractères dont `lexemes` a été produit (utilisée pour les messages d'erreur)
  */
-#define PRIMITIVE(p) void p (Lexeme *lexemes, size_t n, size_t *i, vstack *stack, const char *s)
+#define PRIMITIVE(p) void p (Lexeme *lexemes, size_t n, size_t *i, const Actions *actions, const char *s)
 
 PRIMITIVE(Expr);
 PRIMITIVE(UnionOp);
@@ -186,28 +197,36 @@ PRIMITIVE(KleeneVal);
 /**
  * Définition de l'alphabet
  */
-static const char *SIGMA = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+static const char *SIGMA = SIGMA_REGEX;
 
 
 /**
- * Transforme un flux d'unités lexicales en un AFN.
+ * Analyse syntaxiquement un flux d'unités lexicales en exécutant les actions spécifiées.
  */
-AFN analyse_syntaxique(Lexeme *lexemes, size_t n, const char *s) {
-	vstack stack = vstack_new();
-	
+void analyse_syntaxique(Lexeme *lexemes, size_t n, const char *s, const Actions *actions) {
 	size_t i = 0;
-	Expr(lexemes, n, &i, &stack, s);
+	Expr(lexemes, n, &i, actions, s);
 	
 	if(i < n) {
 		eprintln(s, i, n - i);
 		fprintf(stderr, "erreur syntaxique: caractères en surplus\n");
-		exit(1);
+		exit(compregex_code_erreur);
 	}
+}
+
+
+/**
+ * Analyse l'expression régulière spécifiée en exécutant les actions spécifiées à chaque règle reconnue.
+ *
+ * Remarque:
+ * - Une erreur lexicale ou syntaxique termine le programme, comme pour `compile(const char*)`.
+ */
+void analyser(const char *s, const Actions *actions) {
+	size_t n;
+	Lexeme *lexemes = analyse_lexicale(s, &n);
 	
-	AFN A = vstack_pop(&stack);
-	vstack_free(&stack); // affiche un warning si jamais la pile n'est pas vide
-	
-	return A;
+	analyse_syntaxique(lexemes, n, s, actions);
+	free(lexemes);
 }
 
 
@@ -218,7 +237,7 @@ AFN analyse_syntaxique(Lexeme *lexemes, size_t n, const char *s) {
 /**
  * Appel d'une primitive avec les paramètres de la primitive courante.
  */
-#define INVOKE(p) p (lexemes, n, i, stack, s)
+#define INVOKE(p) p (lexemes, n, i, actions, s)
 
 /**
  * Renvoie le caractère du lexème en cours de traitement.
@@ -255,15 +274,7 @@ PRIMITIVE(UnionOp) {
 		SEEK(1);
 		INVOKE(UnionVal);
 		
-		AFN rhs = vstack_pop(stack);
-		AFN lhs = vstack_pop(stack);
-		
-		AFN U = afn_union(lhs, rhs);
-		
-		afn_free(rhs);
-		afn_free(lhs);
-		
-		vstack_push(stack, U);
+		actions->unir(actions->ctx);
 		
 		INVOKE(UnionOp);
 	}
@@ -285,15 +296,7 @@ PRIMITIVE(ConcatOp) {
 		
 		INVOKE(ConcatVal);
 		
-		AFN rhs = vstack_pop(stack);
-		AFN lhs = vstack_pop(stack);
-		
-		AFN C = afn_concat(lhs, rhs);
-		
-		afn_free(rhs);
-		afn_free(lhs);
-		
-		vstack_push(stack, C);
+		actions->concatener(actions->ctx);
 		
 		INVOKE(ConcatOp);
 	}
@@ -308,12 +311,7 @@ PRIMITIVE(KleeneOp) {
 	while(PEEK_EQ('*')) {
 		SEEK(1);
 		
-		AFN hs = vstack_pop(stack);
-		AFN K = afn_kleene(hs);
-		
-		afn_free(hs);
-		
-		vstack_push(stack, K);
+		actions->etoile(actions->ctx);
 	}
 }
 
@@ -325,37 +323,614 @@ PRIMITIVE(KleeneVal) {
 		if(!PEEK_EQ(')')) {
 			eprintln(s, *i, 1);
 			fprintf(stderr, "erreur syntaxique: parenthèse fermante attendue\n");
-			exit(1);
+			exit(compregex_code_erreur);
 		}
 		
 		SEEK(1);
 	}
 	else {
 		if(PEEK_IS_CHAR()) {
-			char c = PEEK();
-			AFN A = afn_char(c, SIGMA);
-			
-			vstack_push(stack, A);
+			actions->symbole(actions->ctx, PEEK());
 			
 			SEEK(1);
 		}
 		else {
 			eprintln(s, *i, 1);
 			fprintf(stderr, "erreur syntaxique: symbole attendu\n");
-			exit(1);
+			exit(compregex_code_erreur);
 		}
 	}
 }
 
+
+/**
+ * Actions de construction par opérateurs : chaque opérateur produit un nouvel AFN avec
+ * `afn_union()`, `afn_concat()` ou `afn_kleene()`, sur une pile d'AFN (`vstack`).
+ */
+
+static void operateurs_symbole(void *ctx, char c) {
+	vstack_push(ctx, afn_char(c, SIGMA));
+}
+
+static void operateurs_unir(void *ctx) {
+	AFN rhs = vstack_pop(ctx);
+	AFN lhs = vstack_pop(ctx);
+	
+	AFN U = afn_union(lhs, rhs);
+	
+	afn_free(rhs);
+	afn_free(lhs);
+	
+	vstack_push(ctx, U);
+}
+
+static void operateurs_concatener(void *ctx) {
+	AFN rhs = vstack_pop(ctx);
+	AFN lhs = vstack_pop(ctx);
+	
+	AFN C = afn_concat(lhs, rhs);
+	
+	afn_free(rhs);
+	afn_free(lhs);
+	
+	vstack_push(ctx, C);
+}
+
+static void operateurs_etoile(void *ctx) {
+	AFN hs = vstack_pop(ctx);
+	AFN K = afn_kleene(hs);
+	
+	afn_free(hs);
+	
+	vstack_push(ctx, K);
+}
+
+
+/**
+ * Représente un ensemble de fragments d'AFN construits dans un même réservoir d'états.
+ *
+ * Un fragment est un état de départ et une liste d'arêtes pendantes, c.-à-d. dont l'état d'arrivée
+ * n'est pas encore connu. Une arête pendante utilise son champ `q2` pour désigner l'arête pendante
+ * suivante de sa liste (ou `-1`), si bien que concaténer deux listes et les raccorder se fait sans allocation.
+ *
+ * Chaque opérateur ajoute au plus un état et deux arêtes : la construction est linéaire en la taille de l'expression.
+ */
+typedef struct {
+	/**
+	 * Le nombre d'états créés.
+	 */
+	int nbEtats;
+	
+	/**
+	 * Les arêtes ; le champ `q2` d'une arête pendante désigne l'arête pendante suivante de sa liste.
+	 */
+	tbuf aretes;
+	
+	/**
+	 * La pile des fragments, chacun représenté par trois entiers empilés dans l'ordre :
+	 * l'état de départ, la première puis la dernière arête pendante.
+	 */
+	stack pile;
+} Fragments;
+
+
+/**
+ * Ajoute un état au réservoir et renvoie son nom.
+ */
+static int fragments_etat(Fragments *R) {
+	return R->nbEtats++;
+}
+
+
+/**
+ * Ajoute une arête `q1 --c--> q2` au réservoir et renvoie son indice ; `q2` vaut `-1` pour une arête pendante.
+ */
+static int fragments_arete(Fragments *R, int q1, char c, int q2) {
+	return (int) tbuf_push(&R->aretes, q1, c, q2);
+}
+
+
+/**
+ * Raccorde à l'état `q` toutes les arêtes pendantes de la liste commençant par l'arête `tete`.
+ */
+static void fragments_raccorder(Fragments *R, int tete, int q) {
+	while(tete != -1) {
+		int suivante = R->aretes.buf[tete].q2;
+		R->aretes.buf[tete].q2 = q;
+		tete = suivante;
+	}
+}
+
+
+static void fragments_empiler(Fragments *R, int debut, int tete, int queue) {
+	stack_push(&R->pile, debut);
+	stack_push(&R->pile, tete);
+	stack_push(&R->pile, queue);
+}
+
+
+static void fragments_depiler(Fragments *R, int *debut, int *tete, int *queue) {
+	*queue = stack_pop(&R->pile);
+	*tete = stack_pop(&R->pile);
+	*debut = stack_pop(&R->pile);
+}
+
+
+/**
+ * Actions de construction par fragments.
+ */
+
+static void fragments_symbole(void *ctx, char c) {
+	Fragments *R = ctx;
+	
+	int q = fragments_etat(R);
+	int e = fragments_arete(R, q, c, -1);
+	
+	fragments_empiler(R, q, e, e);
+}
+
+static void fragments_unir(void *ctx) {
+	Fragments *R = ctx;
+	
+	int debut2, tete2, queue2;
+	int debut1, tete1, queue1;
+	fragments_depiler(R, &debut2, &tete2, &queue2);
+	fragments_depiler(R, &debut1, &tete1, &queue1);
+	
+	int q = fragments_etat(R);
+	fragments_arete(R, q, EPSILON, debut1);
+	fragments_arete(R, q, EPSILON, debut2);
+	
+	// concaténation des deux listes d'arêtes pendantes
+	R->aretes.buf[queue1].q2 = tete2;
+	
+	fragments_empiler(R, q, tete1, queue2);
+}
+
+static void fragments_concatener(void *ctx) {
+	Fragments *R = ctx;
+	
+	int debut2, tete2, queue2;
+	int debut1, tete1, queue1;
+	fragments_depiler(R, &debut2, &tete2, &queue2);
+	fragments_depiler(R, &debut1, &tete1, &queue1);
+	
+	fragments_raccorder(R, tete1, debut2);
+	
+	fragments_empiler(R, debut1, tete2, queue2);
+}
+
+static void fragments_etoile(void *ctx) {
+	Fragments *R = ctx;
+	
+	int debut, tete, queue;
+	fragments_depiler(R, &debut, &tete, &queue);
+	
+	// `q` accepte le mot vide, mène au fragment et reçoit ses sorties
+	int q = fragments_etat(R);
+	fragments_arete(R, q, EPSILON, debut);
+	fragments_raccorder(R, tete, q);
+	
+	int e = fragments_arete(R, q, EPSILON, -1);
+	fragments_empiler(R, q, e, e);
+}
+
+
 /**
  * Transforme la chaîne de caractères spécifiée en un AFN.
+ *
+ * L'expression est d'abord simplifiée sous forme d'arbre syntaxique (voir `ast_simplifier(Ast)`), puis
+ * l'AFN est construit par fragments dans un unique réservoir d'états, en temps et en mémoire
+ * linéaires en la taille de l'arbre simplifié.
  */
 AFN compile(const char *s) {
-	size_t n;
-	Lexeme *lexemes = analyse_lexicale(s, &n);
+	Ast T = ast_simplifier(ast_analyser(s));
 	
-	AFN A = analyse_syntaxique(lexemes, n, s);
-	free(lexemes);
+	Fragments R;
+	R.nbEtats = 0;
+	R.aretes = tbuf_new_empty();
+	R.pile = stack_new_empty();
+	
+	Actions actions = { &R, fragments_symbole, fragments_unir, fragments_concatener, fragments_etoile };
+	ast_rejouer(T, &actions);
+	ast_free(T);
+	
+	// toutes les arêtes pendantes du fragment final mènent à l'unique état final
+	int debut, tete, queue;
+	fragments_depiler(&R, &debut, &tete, &queue);
+	
+	int final = fragments_etat(&R);
+	fragments_raccorder(&R, tete, final);
+	
+	AFN A = afn_init(R.nbEtats - 1, 1, &debut, 1, &final, SIGMA);
+	afn_ajouter_transitions(A, &R.aretes);
+	STATS_AJOUTER(etats, R.nbEtats);
+	
+	tbuf_free(&R.aretes);
+	stack_free(&R.pile);
+	return A;
+}
+
+
+/**
+ * Transforme la chaîne de caractères spécifiée en un AFN, en appliquant successivement `afn_union()`,
+ * `afn_concat()` et `afn_kleene()`.
+ *
+ * Remarque:
+ * - Chaque opérateur recopie les AFN de ses opérandes : le temps de construction est quadratique en
+ *   la longueur de l'expression. Préférer `compile(const char*)`.
+ */
+AFN compile_operateurs(const char *s) {
+	vstack stack = vstack_new();
+	
+	Actions actions = { &stack, operateurs_symbole, operateurs_unir, operateurs_concatener, operateurs_etoile };
+	analyser(s, &actions);
+	
+	AFN A = vstack_pop(&stack);
+	vstack_free(&stack); // affiche un warning si jamais la pile n'est pas vide
 	
 	return A;
 }
+
+
+/**
+ * Les caractères de l'alphabet, du plus fréquent au moins fréquent dans un texte usuel (journaux, texte anglais).
+ */
+static const char *FREQUENCES = "etaoinsrhldcu0m1fpg2ywb3v45k6789xjqzSETAICRNOLDPMUHFGBWVYKXJQZ";
+
+
+/**
+ * Renvoie le rang de fréquence du caractère `c` : plus il est grand, plus `c` est fréquent.
+ */
+static int frequence(char c) {
+	const char *p = strchr(FREQUENCES, c);
+	int n = (int) strlen(FREQUENCES);
+	
+	return (p == NULL || c == '\0') ? 0 : (n - (int) (p - FREQUENCES));
+}
+
+
+/**
+ * Renvoie `1` si le littéral `a` est plus rare que `b` : son caractère le plus rare est moins fréquent,
+ * ou, à égalité, il est plus long.
+ */
+static int plus_rare(const char *a, const char *b) {
+	int fa = 1 << 30, fb = 1 << 30;
+	
+	for(const char *p = a; *p != '\0'; ++p) {
+		if(frequence(*p) < fa) fa = frequence(*p);
+	}
+	
+	for(const char *p = b; *p != '\0'; ++p) {
+		if(frequence(*p) < fb) fb = frequence(*p);
+	}
+	
+	return fa < fb || (fa == fb && strlen(a) > strlen(b));
+}
+
+
+/**
+ * Renvoie une copie des `n` premiers caractères de `s`, tronquée à `LITTERAL_MAX` caractères.
+ */
+static char* litteral_prefixe(const char *s, size_t n) {
+	if(n > LITTERAL_MAX) {
+		n = LITTERAL_MAX;
+	}
+	
+	char *out = checked_malloc(n + 1);
+	memcpy(out, s, n);
+	out[n] = '\0';
+	
+	return out;
+}
+
+
+/**
+ * Renvoie une copie des `LITTERAL_MAX` derniers caractères (au plus) de `s`.
+ */
+static char* litteral_suffixe(const char *s) {
+	size_t n = strlen(s);
+	
+	return litteral_prefixe(s + (n > LITTERAL_MAX ? n - LITTERAL_MAX : 0), n);
+}
+
+
+/**
+ * Renvoie la concaténation de `a` et `b`, sans troncature.
+ */
+static char* mot_concat(const char *a, const char *b) {
+	size_t la = strlen(a), lb = strlen(b);
+	
+	char *out = checked_malloc(la + lb + 1);
+	memcpy(out, a, la);
+	memcpy(out + la, b, lb + 1);
+	
+	return out;
+}
+
+
+/**
+ * Renvoie la concaténation de `a` et `b` ; si elle est trop longue, seuls les derniers caractères de `a`
+ * et les premiers de `b` sont conservés, afin de garder la jonction des deux.
+ */
+static char* litteral_jonction(const char *a, const char *b) {
+	size_t la = strlen(a), lb = strlen(b);
+	
+	if(la > LITTERAL_MAX / 2 && la + lb > LITTERAL_MAX) {
+		size_t garde = (lb < LITTERAL_MAX / 2) ? (LITTERAL_MAX - lb) : (LITTERAL_MAX / 2);
+		a += la - garde;
+		la = garde;
+	}
+	
+	char *out = checked_malloc(la + lb + 1);
+	memcpy(out, a, la);
+	memcpy(out + la, b, lb + 1);
+	
+	// `b` est tronqué par la fin : sa partie conservée reste un facteur obligatoire
+	out[la + lb > LITTERAL_MAX ? LITTERAL_MAX : la + lb] = '\0';
+	return out;
+}
+
+
+/**
+ * Renvoie le plus long facteur commun à `a` et `b` (le premier dans `a` en cas d'égalité).
+ */
+static char* plus_long_facteur_commun(const char *a, const char *b) {
+	size_t la = strlen(a), lb = strlen(b);
+	size_t debut = 0, longueur = 0;
+	
+	// les littéraux comptant au plus `LITTERAL_MAX` caractères, la recherche exhaustive suffit
+	for(size_t i = 0; i < la; ++i) {
+		for(size_t j = 0; j < lb; ++j) {
+			size_t k = 0;
+			while(i + k < la && j + k < lb && a[i + k] == b[j + k]) {
+				++k;
+			}
+			
+			if(k > longueur) {
+				debut = i;
+				longueur = k;
+			}
+		}
+	}
+	
+	return litteral_prefixe(a + debut, longueur);
+}
+
+
+/**
+ * Ajoute le littéral `r` (dont la propriété est cédée) aux facteurs obligatoires de `L`, sauf s'il est vide
+ * ou déjà contenu dans l'un d'eux ; au-delà de `REQUIS_MAX` facteurs, le moins rare est abandonné.
+ */
+static void litteraux_requerir(Litteraux *L, char *r) {
+	if(*r == '\0') {
+		free(r);
+		return;
+	}
+	
+	for(int i = 0; i < L->nbRequis; ++i) {
+		if(strstr(L->requis[i], r) != NULL) {
+			free(r);
+			return;
+		}
+	}
+	
+	if(L->nbRequis == REQUIS_MAX) {
+		int commun = 0;
+		for(int i = 1; i < L->nbRequis; ++i) {
+			if(plus_rare(L->requis[commun], L->requis[i])) {
+				commun = i;
+			}
+		}
+		
+		if(plus_rare(L->requis[commun], r)) {
+			free(r);
+		}
+		else {
+			free(L->requis[commun]);
+			L->requis[commun] = r;
+		}
+		
+		return;
+	}
+	
+	L->requis = checked_realloc(L->requis, (L->nbRequis + 1) * sizeof(char*));
+	L->requis[L->nbRequis++] = r;
+}
+
+
+/**
+ * Renvoie des littéraux vides, ceux du langage contenant le mot vide.
+ */
+static Litteraux litteraux_vides() {
+	Litteraux L;
+	L.complet = NULL;
+	L.prefixe = litteral_prefixe("", 0);
+	L.suffixe = litteral_prefixe("", 0);
+	L.requis = NULL;
+	L.nbRequis = 0;
+	
+	return L;
+}
+
+
+/**
+ * Représente une pile de littéraux, un élément par sous-expression en attente de son opérateur.
+ */
+typedef struct {
+	Litteraux *buf;
+	size_t len;
+	size_t capacity;
+} PileLitteraux;
+
+
+static void litteraux_empiler(PileLitteraux *P, Litteraux L) {
+	if(P->len == P->capacity) {
+		P->capacity = P->capacity > 0 ? 2 * P->capacity : 8;
+		P->buf = checked_realloc(P->buf, P->capacity * sizeof(Litteraux));
+	}
+	
+	P->buf[P->len++] = L;
+}
+
+
+static Litteraux litteraux_depiler(PileLitteraux *P) {
+	return P->buf[--P->len];
+}
+
+
+/**
+ * Actions d'extraction des littéraux.
+ */
+
+static void litteraux_symbole(void *ctx, char c) {
+	char mot[2] = { c, '\0' };
+	
+	Litteraux L = litteraux_vides();
+	free(L.prefixe);
+	free(L.suffixe);
+	
+	L.complet = litteral_prefixe(mot, 1);
+	L.prefixe = litteral_prefixe(mot, 1);
+	L.suffixe = litteral_prefixe(mot, 1);
+	litteraux_requerir(&L, litteral_prefixe(mot, 1));
+	
+	litteraux_empiler(ctx, L);
+}
+
+static void litteraux_concatener(void *ctx) {
+	Litteraux B = litteraux_depiler(ctx);
+	Litteraux A = litteraux_depiler(ctx);
+	Litteraux C = litteraux_vides();
+	free(C.prefixe);
+	free(C.suffixe);
+	
+	// un mot complet trop long devient un simple préfixe (et suffixe) tronqué
+	if(A.complet != NULL && B.complet != NULL && strlen(A.complet) + strlen(B.complet) <= LITTERAL_MAX) {
+		C.complet = mot_concat(A.complet, B.complet);
+	}
+	
+	char *prefixe = mot_concat(A.complet != NULL ? A.complet : A.prefixe, A.complet != NULL ? B.prefixe : "");
+	C.prefixe = litteral_prefixe(prefixe, strlen(prefixe));
+	free(prefixe);
+	
+	char *suffixe = mot_concat(B.complet != NULL ? A.suffixe : "", B.suffixe);
+	C.suffixe = litteral_suffixe(suffixe);
+	free(suffixe);
+	
+	// les facteurs de `A` et de `B` restent obligatoires, ainsi que la jonction du suffixe de `A` et du préfixe de `B`
+	if(C.complet != NULL) {
+		litteraux_requerir(&C, litteral_prefixe(C.complet, strlen(C.complet)));
+	}
+	
+	litteraux_requerir(&C, litteral_jonction(A.suffixe, B.prefixe));
+	
+	for(int i = 0; i < A.nbRequis; ++i) {
+		litteraux_requerir(&C, litteral_prefixe(A.requis[i], strlen(A.requis[i])));
+	}
+	
+	for(int i = 0; i < B.nbRequis; ++i) {
+		litteraux_requerir(&C, litteral_prefixe(B.requis[i], strlen(B.requis[i])));
+	}
+	
+	litteraux_free(&A);
+	litteraux_free(&B);
+	litteraux_empiler(ctx, C);
+}
+
+static void litteraux_unir(void *ctx) {
+	Litteraux B = litteraux_depiler(ctx);
+	Litteraux A = litteraux_depiler(ctx);
+	Litteraux U = litteraux_vides();
+	free(U.prefixe);
+	free(U.suffixe);
+	
+	if(A.complet != NULL && B.complet != NULL && strcmp(A.complet, B.complet) == 0) {
+		U.complet = litteral_prefixe(A.complet, strlen(A.complet));
+	}
+	
+	// préfixe et suffixe communs
+	size_t p = 0;
+	while(A.prefixe[p] != '\0' && A.prefixe[p] == B.prefixe[p]) {
+		++p;
+	}
+	
+	size_t la = strlen(A.suffixe), lb = strlen(B.suffixe), k = 0;
+	while(k < la && k < lb && A.suffixe[la - 1 - k] == B.suffixe[lb - 1 - k]) {
+		++k;
+	}
+	
+	U.prefixe = litteral_prefixe(A.prefixe, p);
+	U.suffixe = litteral_prefixe(A.suffixe + la - k, k);
+	
+	litteraux_requerir(&U, litteral_prefixe(U.prefixe, p));
+	litteraux_requerir(&U, litteral_prefixe(U.suffixe, k));
+	
+	// tout facteur commun à un facteur obligatoire de `A` et à un facteur obligatoire de `B` est obligatoire dans l'union
+	for(int i = 0; i < A.nbRequis; ++i) {
+		for(int j = 0; j < B.nbRequis; ++j) {
+			litteraux_requerir(&U, plus_long_facteur_commun(A.requis[i], B.requis[j]));
+		}
+	}
+	
+	litteraux_free(&A);
+	litteraux_free(&B);
+	litteraux_empiler(ctx, U);
+}
+
+static void litteraux_etoile(void *ctx) {
+	Litteraux A = litteraux_depiler(ctx);
+	litteraux_free(&A);
+	
+	// le mot vide appartient au langage : aucun littéral n'est imposé
+	litteraux_empiler(ctx, litteraux_vides());
+}
+
+
+/**
+ * Calcule les littéraux imposés par l'expression régulière spécifiée.
+ */
+Litteraux litteraux_extraire(const char *s) {
+	PileLitteraux P = { NULL, 0, 0 };
+	
+	Actions actions = { &P, litteraux_symbole, litteraux_unir, litteraux_concatener, litteraux_etoile };
+	analyser(s, &actions);
+	
+	Litteraux L = litteraux_depiler(&P);
+	free(P.buf);
+	
+	return L;
+}
+
+
+/**
+ * Renvoie le littéral obligatoire le plus rare, estimé d'après la fréquence usuelle de ses caractères,
+ * ou `NULL` si aucun littéral n'est obligatoire.
+ */
+const char* litteraux_plus_rare(const Litteraux *L) {
+	const char *rare = NULL;
+	
+	for(int i = 0; i < L->nbRequis; ++i) {
+		if(rare == NULL || plus_rare(L->requis[i], rare)) {
+			rare = L->requis[i];
+		}
+	}
+	
+	return rare;
+}
+
+
+/**
+ * Libère les ressources allouées à des littéraux.
+ */
+void litteraux_free(Litteraux *L) {
+	free(L->complet);
+	free(L->prefixe);
+	free(L->suffixe);
+	
+	for(int i = 0; i < L->nbRequis; ++i) {
+		free(L->requis[i]);
+	}
+	
+	free(L->requis);
+}
@@ -3,9 +3,141 @@
 
 #include "afn.h"
 
+/**
+ * L'alphabet des expressions régulières, et donc celui des AFN produits par `compile(const char*)`.
+ */
+#define SIGMA_REGEX "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+
+/**
+ * Le code de sortie du programme en cas d'erreur lexicale ou syntaxique dans une expression régulière ;
+ * vaut `1` par défaut.
+ */
+extern int compregex_code_erreur;
+
+
+/**
+ * Représente les actions exécutées par l'analyseur syntaxique à chaque règle reconnue.
+ *
+ * L'analyseur ne construit rien lui-même : chaque action empile ou dépile des valeurs dans `ctx`,
+ * en notation postfixe (les opérandes d'un opérateur sont toujours reconnues avant lui).
+ */
+typedef struct {
+	/**
+	 * Le contexte passé à chaque action.
+	 */
+	void *ctx;
+	
+	/**
+	 * Empile la valeur associée au symbole `c`.
+	 */
+	void (*symbole)(void *ctx, char c);
+	
+	/**
+	 * Dépile deux valeurs et empile leur union.
+	 */
+	void (*unir)(void *ctx);
+	
+	/**
+	 * Dépile deux valeurs et empile leur concaténation.
+	 */
+	void (*concatener)(void *ctx);
+	
+	/**
+	 * Dépile une valeur et empile son étoile de Kleene.
+	 */
+	void (*etoile)(void *ctx);
+} Actions;
+
+
+/**
+ * Analyse l'expression régulière spécifiée en exécutant les actions spécifiées à chaque règle reconnue.
+ *
+ * Remarque:
+ * - Une erreur lexicale ou syntaxique termine le programme, comme pour `compile(const char*)`.
+ */
+void analyser(const char *s, const Actions *actions);
+
+
 /**
  * Transforme la chaîne de caractères spécifiée en un AFN.
  */
 AFN compile(const char *s);
 
+
+/**
+ * Transforme la chaîne de caractères spécifiée en un AFN, en appliquant successivement `afn_union()`,
+ * `afn_concat()` et `afn_kleene()`.
+ *
+ * Remarque:
+ * - Chaque opérateur recopie les AFN de ses opérandes : le temps de construction est quadratique en
+ *   la longueur de l'expression. Préférer `compile(const char*)`.
+ */
+AFN compile_operateurs(const char *s);
+
+
+
+/**
+ * Représente les littéraux qu'une expression régulière impose à tous les mots de son langage.
+ *
+ * Chaque chaîne est terminée par '\0' et compte au plus `LITTERAL_MAX` caractères ; une chaîne vide
+ * signifie qu'aucun littéral n'est connu.
+ */
+typedef struct {
+	/**
+	 * L'unique mot du langage, ou `NULL` si le langage n'est pas réduit à un seul mot.
+	 */
+	char *complet;
+	
+	/**
+	 * Un préfixe commun à tous les mots du langage.
+	 */
+	char *prefixe;
+	
+	/**
+	 * Un suffixe commun à tous les mots du langage.
+	 */
+	char *suffixe;
+	
+	/**
+	 * Des facteurs non vides que tout mot du langage contient, chacun d'eux étant obligatoire.
+	 */
+	char **requis;
+	
+	/**
+	 * Le nombre de facteurs de `requis`.
+	 */
+	int nbRequis;
+} Litteraux;
+
+
+/**
+ * La longueur maximale d'un littéral extrait ; tout facteur d'un littéral obligatoire étant lui aussi
+ * obligatoire, les littéraux plus longs sont simplement tronqués.
+ */
+#define LITTERAL_MAX 32
+
+/**
+ * Le nombre maximal de facteurs obligatoires conservés ; au-delà, seuls les plus rares sont gardés.
+ */
+#define REQUIS_MAX 8
+
+
+/**
+ * Calcule les littéraux imposés par l'expression régulière spécifiée.
+ */
+Litteraux litteraux_extraire(const char *s);
+
+
+/**
+ * Renvoie le littéral obligatoire le plus rare, estimé d'après la fréquence usuelle de ses caractères,
+ * ou `NULL` si aucun littéral n'est obligatoire.
+ */
+const char* litteraux_plus_rare(const Litteraux *L);
+
+
+/**
+ * Libère les ressources allouées à des littéraux.
+ */
+void litteraux_free(Litteraux *L);
+
 #endif // COMPREGEX_H
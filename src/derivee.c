@@ -0,0 +1,476 @@
+#include "derivee.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ast.h"
+#include "compregex.h"
+#include "util/misc.h"
+#include "util/set.h"
+#include "util/stack.h"
+
+/**
+ * Représente le type d'une expression.
+ */
+typedef enum {
+	Vide,
+	MotVide,
+	Symbole,
+	Concat,
+	Union,
+	Etoile
+} Type;
+
+
+/**
+ * Représente une expression, identifiée par son indice dans la fabrique.
+ *
+ * Une union est une liste `a + (b + (...))` dont les éléments (qui ne sont pas des unions) sont triés par
+ * identifiant strictement croissant ; une concaténation est associée à droite.
+ */
+typedef struct {
+	Type type;
+	char c;
+	int a;
+	int b;
+	int nullable;
+	
+	/**
+	 * L'état de l'AFD correspondant à l'expression, ou `-1` si elle n'en est pas (encore) un.
+	 */
+	int etat;
+} Expression;
+
+
+/**
+ * Représente une table de hachage associant une valeur à une clé de trois entiers.
+ */
+typedef struct {
+	int (*cles)[3];
+	int *valeurs;
+	size_t len;
+	size_t capacity;
+	
+	/**
+	 * La table d'adressage ouvert : chaque case contient un indice de `cles`, ou `-1` si elle est libre.
+	 */
+	int *table;
+	size_t tableCapacity;
+} Table;
+
+
+/**
+ * Représente l'ensemble des expressions construites : chacune n'existe qu'en un seul exemplaire.
+ */
+typedef struct {
+	Expression *buf;
+	size_t len;
+	size_t capacity;
+	
+	/**
+	 * Associe `(type, a, b)` (`a` valant le symbole pour `Symbole`) à l'identifiant de l'expression.
+	 */
+	Table uniques;
+	
+	/**
+	 * Associe `(r, j, 0)` à l'identifiant de la dérivée de `r` par le symbole `SIGMA_REGEX[j]`.
+	 */
+	Table derivees;
+	
+	/**
+	 * `present[c]` vaut `1` si le symbole `c` apparaît dans l'expression.
+	 */
+	char present[256];
+} Fabrique;
+
+#define VIDE 0
+#define MOT_VIDE 1
+
+
+/**
+ * Calcul l'empreinte d'une clé (FNV-1a sur ses trois entiers).
+ */
+static size_t table_hash(const int *cle) {
+	size_t h = (size_t) 14695981039346656037ULL;
+	
+	for(int i = 0; i < 3; ++i) {
+		h ^= (size_t) (unsigned int) cle[i];
+		h *= (size_t) 1099511628211ULL;
+	}
+	
+	return h;
+}
+
+
+/**
+ * Renvoie l'indice de la case de `table` contenant la clé spécifiée, ou de la case libre où elle devrait être insérée.
+ */
+static size_t table_probe(const Table *T, const int *cle) {
+	size_t mask = T->tableCapacity - 1;
+	size_t i = table_hash(cle) & mask;
+	
+	while(T->table[i] != -1 && memcmp(T->cles[T->table[i]], cle, sizeof(T->cles[0])) != 0) {
+		i = (i + 1) & mask;
+	}
+	
+	return i;
+}
+
+
+/**
+ * Renvoie la valeur associée à la clé spécifiée, ou `-1` si elle est absente.
+ */
+static int table_get(const Table *T, const int *cle) {
+	if(T->tableCapacity == 0) {
+		return -1;
+	}
+	
+	int k = T->table[table_probe(T, cle)];
+	return (k == -1) ? -1 : T->valeurs[k];
+}
+
+
+/**
+ * Associe la valeur spécifiée à la clé spécifiée, absente de la table.
+ */
+static void table_put(Table *T, const int *cle, int valeur) {
+	// on garde un facteur de remplissage inférieur à 1/2
+	if(2 * (T->len + 1) > T->tableCapacity) {
+		free(T->table);
+		
+		T->tableCapacity = (T->tableCapacity == 0) ? 64 : (T->tableCapacity * 2);
+		T->table = checked_malloc(T->tableCapacity * sizeof(int));
+		memset(T->table, -1, T->tableCapacity * sizeof(int));
+		
+		for(size_t k = 0; k < T->len; ++k) {
+			T->table[table_probe(T, T->cles[k])] = (int) k;
+		}
+	}
+	
+	if(T->len == T->capacity) {
+		T->capacity = (T->capacity == 0) ? 64 : (T->capacity * 2);
+		T->cles = checked_realloc(T->cles, T->capacity * sizeof(T->cles[0]));
+		T->valeurs = checked_realloc(T->valeurs, T->capacity * sizeof(int));
+	}
+	
+	memcpy(T->cles[T->len], cle, sizeof(T->cles[0]));
+	T->valeurs[T->len] = valeur;
+	T->table[table_probe(T, cle)] = (int) T->len;
+	++(T->len);
+}
+
+
+static void table_free(Table *T) {
+	free(T->cles);
+	free(T->valeurs);
+	free(T->table);
+}
+
+
+/**
+ * Renvoie l'identifiant de l'expression `(type, a, b)`, en la créant si elle n'existe pas encore.
+ * Aucune simplification n'est faite ici : voir `expression_union()`, `expression_concat()` et `expression_etoile()`.
+ */
+static int expression(Fabrique *F, Type type, int a, int b) {
+	int cle[3] = { (int) type, a, b };
+	
+	int e = table_get(&F->uniques, cle);
+	if(e != -1) {
+		return e;
+	}
+	
+	if(F->len == F->capacity) {
+		F->capacity = (F->capacity == 0) ? 64 : (F->capacity * 2);
+		F->buf = checked_realloc(F->buf, F->capacity * sizeof(Expression));
+	}
+	
+	Expression *E = &F->buf[F->len];
+	E->type = type;
+	E->c = (type == Symbole) ? (char) a : '\0';
+	E->a = a;
+	E->b = b;
+	E->etat = -1;
+	
+	switch(type) {
+		case Vide:    E->nullable = 0; break;
+		case MotVide: E->nullable = 1; break;
+		case Symbole: E->nullable = 0; break;
+		case Concat:  E->nullable = F->buf[a].nullable && F->buf[b].nullable; break;
+		case Union:   E->nullable = F->buf[a].nullable || F->buf[b].nullable; break;
+		case Etoile:  E->nullable = 1; break;
+	}
+	
+	e = (int) F->len++;
+	table_put(&F->uniques, cle, e);
+	
+	return e;
+}
+
+
+/**
+ * Ajoute à `*elements` les éléments de l'union `r` (ou `r` lui-même si ce n'est pas une union), sauf ∅.
+ */
+static void expression_elements(Fabrique *F, int r, set *elements) {
+	while(F->buf[r].type == Union) {
+		set_push(elements, F->buf[r].a);
+		r = F->buf[r].b;
+	}
+	
+	if(r != VIDE) {
+		set_push(elements, r);
+	}
+}
+
+
+/**
+ * Renvoie l'union normalisée des éléments spécifiés, triés et sans doublon, ou ∅ s'il n'y en a aucun.
+ */
+static int expression_liste(Fabrique *F, set elements) {
+	if(elements.len == 0) {
+		return VIDE;
+	}
+	
+	int u = elements.buf[elements.len - 1];
+	for(size_t i = elements.len - 1; i-- > 0; ) {
+		u = expression(F, Union, elements.buf[i], u);
+	}
+	
+	return u;
+}
+
+
+/**
+ * Renvoie l'union normalisée de `r` et `s` : les deux listes sont fusionnées, triées et sans doublon.
+ */
+static int expression_union(Fabrique *F, int r, int s) {
+	if(r == s || s == VIDE) {
+		return r;
+	}
+	
+	if(r == VIDE) {
+		return s;
+	}
+	
+	set elements = set_new_empty();
+	expression_elements(F, r, &elements);
+	expression_elements(F, s, &elements);
+	
+	int u = expression_liste(F, elements);
+	
+	set_free(&elements);
+	return u;
+}
+
+
+/**
+ * Renvoie la concaténation normalisée de `r` et `s`.
+ */
+static int expression_concat(Fabrique *F, int r, int s) {
+	if(r == VIDE || s == VIDE) {
+		return VIDE;
+	}
+	
+	if(r == MOT_VIDE) {
+		return s;
+	}
+	
+	if(s == MOT_VIDE) {
+		return r;
+	}
+	
+	// (a.b).s = a.(b.s)
+	if(F->buf[r].type == Concat) {
+		int a = F->buf[r].a;
+		int b = F->buf[r].b;
+		
+		return expression(F, Concat, a, expression_concat(F, b, s));
+	}
+	
+	return expression(F, Concat, r, s);
+}
+
+
+/**
+ * Renvoie l'étoile de Kleene normalisée de `r`.
+ */
+static int expression_etoile(Fabrique *F, int r) {
+	if(r == VIDE || r == MOT_VIDE) {
+		return MOT_VIDE;
+	}
+	
+	if(F->buf[r].type == Etoile) {
+		return r;
+	}
+	
+	return expression(F, Etoile, r, 0);
+}
+
+
+/**
+ * Renvoie la dérivée de `r` par le symbole `c`, d'indice `j` dans `SIGMA_REGEX`.
+ */
+static int expression_deriver(Fabrique *F, int r, char c, int j) {
+	Expression E = F->buf[r];
+	
+	switch(E.type) {
+		case Vide:
+		case MotVide:
+			return VIDE;
+		case Symbole:
+			return (E.c == c) ? MOT_VIDE : VIDE;
+		default:
+			break;
+	}
+	
+	int cle[3] = { r, j, 0 };
+	int d = table_get(&F->derivees, cle);
+	if(d != -1) {
+		return d;
+	}
+	
+	if(E.type == Union) {
+		// τ⁻¹(a + b) = τ⁻¹a + τ⁻¹b
+		d = expression_union(F, expression_deriver(F, E.a, c, j), expression_deriver(F, E.b, c, j));
+	}
+	else if(E.type == Concat) {
+		// τ⁻¹(a.b) = τ⁻¹a.b + τ⁻¹b si a accepte le mot vide
+		d = expression_concat(F, expression_deriver(F, E.a, c, j), E.b);
+		if(F->buf[E.a].nullable) {
+			d = expression_union(F, d, expression_deriver(F, E.b, c, j));
+		}
+	}
+	else {
+		// τ⁻¹(a*) = τ⁻¹a.a*
+		d = expression_concat(F, expression_deriver(F, E.a, c, j), r);
+	}
+	
+	table_put(&F->derivees, cle, d);
+	return d;
+}
+
+
+/**
+ * Renvoie l'expression normalisée de l'arbre syntaxique spécifié.
+ *
+ * Les fils d'une union ou d'une concaténation n-aire sont combinés en une seule fois : les alternatives sont
+ * fusionnées dans un seul ensemble, et les facteurs concaténés de droite à gauche, si bien qu'une concaténation
+ * déjà construite n'est jamais reparcourue (contrairement à `(a.b).s = a.(b.s)` à chaque opérateur).
+ */
+static int expression_ast(Fabrique *F, Ast A) {
+	switch(A->type) {
+		case AST_SYMBOLE:
+			F->present[(unsigned char) A->c] = 1;
+			return expression(F, Symbole, (unsigned char) A->c, 0);
+		case AST_ETOILE:
+			return expression_etoile(F, expression_ast(F, A->fils[0]));
+		case AST_CONCAT: {
+			int r = expression_ast(F, A->fils[A->nbFils - 1]);
+			
+			for(int i = A->nbFils - 1; i-- > 0; ) {
+				r = expression_concat(F, expression_ast(F, A->fils[i]), r);
+			}
+			
+			return r;
+		}
+		case AST_UNION: {
+			set elements = set_new_empty();
+			
+			for(int i = 0; i < A->nbFils; ++i) {
+				expression_elements(F, expression_ast(F, A->fils[i]), &elements);
+			}
+			
+			int u = expression_liste(F, elements);
+			
+			set_free(&elements);
+			return u;
+		}
+	}
+	
+	return VIDE;
+}
+
+
+/**
+ * Construit l'AFD d'une expression régulière par dérivées de Brzozowski, sans passer par un AFN.
+ *
+ * Chaque état de l'AFD est une expression dérivée de l'expression initiale : δ(r, τ) = τ⁻¹r, et r est
+ * final si le mot vide appartient à son langage. Les expressions sont partagées (une seule copie de
+ * chaque sous-expression) et normalisées, l'union étant associative, commutative et idempotente,
+ * ce qui garantit un nombre fini de dérivées distinctes.
+ *
+ * L'alphabet de l'AFD est celui des expressions régulières (`SIGMA_REGEX`) ; la dérivée vide (∅)
+ * n'est pas un état, elle est représentée par `INVALID_STATE`.
+ *
+ * Remarque:
+ * - Une erreur lexicale ou syntaxique termine le programme, comme pour `compile(const char*)`.
+ */
+AFD derivee_compiler(const char *s) {
+	Fabrique F;
+	memset(&F, 0, sizeof(F));
+	
+	expression(&F, Vide, 0, 0);
+	expression(&F, MotVide, 0, 0);
+	
+	// l'arbre syntaxique regroupe les suites de concaténations et d'unions en un seul nœud
+	Ast T = ast_analyser(s);
+	int r0 = expression_ast(&F, T);
+	ast_free(T);
+	
+	const char *Sigma = SIGMA_REGEX;
+	const int lenSigma = (int) strlen(Sigma);
+	
+	// les états sont découverts en largeur : `etats.buf[q]` est l'expression de l'état `q`
+	stack etats = stack_new_with_value(r0);
+	F.buf[etats.buf[0]].etat = 0;
+	
+	// `delta[q * lenSigma + j]` = δ(q, Sigma[j]), les lignes sont ajoutées au fur et à mesure
+	stack delta = stack_new_empty();
+	stack finals = stack_new_empty();
+	
+	for(size_t q = 0; q < etats.len; ++q) {
+		int r = etats.buf[q];
+		if(F.buf[r].nullable) {
+			stack_push(&finals, (int) q);
+		}
+		
+		// une ligne entière par état, la capacité étant doublée au besoin
+		if(delta.len + lenSigma > delta.capacity) {
+			stack_reserve(&delta, delta.capacity + lenSigma);
+		}
+		
+		for(int j = 0; j < lenSigma; ++j) {
+			// un symbole absent de l'expression annule toutes ses dérivées
+			int d = F.present[(unsigned char) Sigma[j]] ? expression_deriver(&F, r, Sigma[j], j) : VIDE;
+			
+			if(d == VIDE) {
+				stack_push(&delta, INVALID_STATE);
+				continue;
+			}
+			
+			if(F.buf[d].etat == -1) {
+				F.buf[d].etat = (int) etats.len;
+				stack_push(&etats, d);
+			}
+			
+			stack_push(&delta, F.buf[d].etat);
+		}
+	}
+	
+	AFD D = afd_init((int) etats.len - 1, 0, (int) finals.len, finals.buf, Sigma);
+	for(int q = 0; q <= D->Q; ++q) {
+		memcpy(D->delta[q], &delta.buf[q * lenSigma], lenSigma * sizeof(int));
+	}
+	
+	// les symboles absents de l'expression, entre autres, partagent ensuite une seule colonne
+	afd_compresser(D);
+	
+	stack_free(&etats);
+	stack_free(&delta);
+	stack_free(&finals);
+	table_free(&F.uniques);
+	table_free(&F.derivees);
+	free(F.buf);
+	
+	return D;
+}
@@ -0,0 +1,22 @@
+#ifndef DERIVEE_H
+#define DERIVEE_H
+
+#include "afd.h"
+
+/**
+ * Construit l'AFD d'une expression régulière par dérivées de Brzozowski, sans passer par un AFN.
+ *
+ * Chaque état de l'AFD est une expression dérivée de l'expression initiale : δ(r, τ) = τ⁻¹r, et r est
+ * final si le mot vide appartient à son langage. Les expressions sont partagées (une seule copie de
+ * chaque sous-expression) et normalisées, l'union étant associative, commutative et idempotente,
+ * ce qui garantit un nombre fini de dérivées distinctes.
+ *
+ * L'alphabet de l'AFD est celui des expressions régulières (`SIGMA_REGEX`) ; la dérivée vide (∅)
+ * n'est pas un état, elle est représentée par `INVALID_STATE`.
+ *
+ * Remarque:
+ * - Une erreur lexicale ou syntaxique termine le programme, comme pour `compile(const char*)`.
+ */
+AFD derivee_compiler(const char *s);
+
+#endif // DERIVEE_H
@@ -0,0 +1,357 @@
+#include "glushkov.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "compregex.h"
+#include "util/misc.h"
+#include "util/tbuf.h"
+
+/**
+ * Représente une sous-expression en attente de son opérateur : seuls ses ensembles `first` et `last`
+ * sont conservés, ses positions ayant déjà reçu leurs `follow` internes.
+ */
+typedef struct {
+	int nullable;
+	set first;
+	set last;
+} Noeud;
+
+
+/**
+ * Représente l'état de la construction : les positions créées et la pile des sous-expressions.
+ */
+typedef struct {
+	/**
+	 * Le nombre de positions créées.
+	 */
+	int m;
+	
+	/**
+	 * Les symboles et les `follow` des positions `0 ... m`, de capacité `capacity`.
+	 */
+	char *symbole;
+	set *follow;
+	int capacity;
+	
+	Noeud *pile;
+	size_t len;
+	size_t lenCapacity;
+} Construction;
+
+
+/**
+ * Remplace l'ensemble `*dst` par son union avec `src`.
+ */
+static void ensemble_unir(set *dst, set src) {
+	if(src.len == 0) {
+		return;
+	}
+	
+	set u = set_union(*dst, src);
+	set_free(dst);
+	*dst = u;
+}
+
+
+/**
+ * Ajoute `src` à `follow[x]` pour toute position `x` de `positions`.
+ */
+static void construction_suivre(Construction *C, set positions, set src) {
+	for(size_t i = 0; i < positions.len; ++i) {
+		ensemble_unir(&C->follow[positions.buf[i]], src);
+	}
+}
+
+
+static void construction_empiler(Construction *C, Noeud N) {
+	if(C->len == C->lenCapacity) {
+		C->lenCapacity = C->lenCapacity > 0 ? 2 * C->lenCapacity : 8;
+		C->pile = checked_realloc(C->pile, C->lenCapacity * sizeof(Noeud));
+	}
+	
+	C->pile[C->len++] = N;
+}
+
+
+static Noeud construction_depiler(Construction *C) {
+	return C->pile[--C->len];
+}
+
+
+/**
+ * Actions de construction de l'automate des positions.
+ */
+
+static void glushkov_symbole(void *ctx, char c) {
+	Construction *C = ctx;
+	
+	int p = ++C->m;
+	if(p == C->capacity) {
+		C->capacity *= 2;
+		C->symbole = checked_realloc(C->symbole, C->capacity * sizeof(char));
+		C->follow = checked_realloc(C->follow, C->capacity * sizeof(set));
+	}
+	
+	C->symbole[p] = c;
+	C->follow[p] = set_new_empty();
+	
+	Noeud N = { 0, set_new_singleton(p), set_new_singleton(p) };
+	construction_empiler(C, N);
+}
+
+static void glushkov_unir(void *ctx) {
+	Noeud B = construction_depiler(ctx);
+	Noeud A = construction_depiler(ctx);
+	
+	ensemble_unir(&A.first, B.first);
+	ensemble_unir(&A.last, B.last);
+	A.nullable |= B.nullable;
+	
+	set_free(&B.first);
+	set_free(&B.last);
+	construction_empiler(ctx, A);
+}
+
+static void glushkov_concatener(void *ctx) {
+	Noeud B = construction_depiler(ctx);
+	Noeud A = construction_depiler(ctx);
+	
+	// toute fin de A peut être suivie d'un début de B
+	construction_suivre(ctx, A.last, B.first);
+	
+	if(A.nullable) {
+		ensemble_unir(&A.first, B.first);
+	}
+	
+	if(B.nullable) {
+		ensemble_unir(&B.last, A.last);
+	}
+	
+	Noeud N = { A.nullable && B.nullable, A.first, B.last };
+	
+	set_free(&A.last);
+	set_free(&B.first);
+	construction_empiler(ctx, N);
+}
+
+static void glushkov_etoile(void *ctx) {
+	Noeud A = construction_depiler(ctx);
+	
+	// toute fin de A peut être suivie d'un nouveau début de A
+	construction_suivre(ctx, A.last, A.first);
+	A.nullable = 1;
+	
+	construction_empiler(ctx, A);
+}
+
+
+/**
+ * Renvoie le masque de 64 bits de l'ensemble de positions spécifié.
+ */
+static uint64_t masque_de(set s) {
+	uint64_t M = 0;
+	for(size_t i = 0; i < s.len; ++i) {
+		M |= (uint64_t) 1 << s.buf[i];
+	}
+	
+	return M;
+}
+
+
+/**
+ * Précalcule les masques de la simulation bit-parallèle.
+ */
+static void glushkov_compiler_masques(Glushkov G) {
+	memset(G->masque, 0, sizeof(G->masque));
+	for(int p = 1; p <= G->m; ++p) {
+		G->masque[(unsigned char) G->symbole[p]] |= (uint64_t) 1 << p;
+	}
+	
+	G->finals = masque_de(G->last) | (G->nullable ? 1 : 0);
+	
+	// `suivants` découpe l'ensemble des états actifs en octets : 8 consultations de table au plus par étape
+	G->nbTables = (G->m + 1 + 7) / 8;
+	G->suivants = checked_malloc(G->nbTables * sizeof(*G->suivants));
+	
+	for(int k = 0; k < G->nbTables; ++k) {
+		uint64_t F[8];
+		for(int i = 0; i < 8; ++i) {
+			int q = 8 * k + i;
+			F[i] = (q <= G->m) ? masque_de(G->follow[q]) : 0;
+		}
+		
+		// `suivants[k][v]` se déduit de `v` privé de son bit de poids faible
+		G->suivants[k][0] = 0;
+		for(int v = 1; v < 256; ++v) {
+			G->suivants[k][v] = G->suivants[k][v & (v - 1)] | F[__builtin_ctz(v)];
+		}
+	}
+}
+
+
+/**
+ * Construit l'AFN sans epsilon-transition de l'automate des positions spécifié.
+ */
+static AFN glushkov_construire_afn(Glushkov G) {
+	int *finals = checked_malloc((G->last.len + 1) * sizeof(int));
+	int nbFinals = 0;
+	
+	if(G->nullable) {
+		finals[nbFinals++] = 0;
+	}
+	
+	for(size_t i = 0; i < G->last.len; ++i) {
+		finals[nbFinals++] = G->last.buf[i];
+	}
+	
+	int initial = 0;
+	AFN A = afn_init(G->m, 1, &initial, nbFinals, finals, SIGMA_REGEX);
+	free(finals);
+	
+	tbuf T = tbuf_new_empty();
+	for(int q = 0; q <= G->m; ++q) {
+		for(size_t i = 0; i < G->follow[q].len; ++i) {
+			int p = G->follow[q].buf[i];
+			tbuf_push(&T, q, G->symbole[p], p);
+		}
+	}
+	
+	afn_ajouter_transitions(A, &T);
+	tbuf_free(&T);
+	
+	A->sansEpsilon = 1;
+	return A;
+}
+
+
+/**
+ * Construit l'automate des positions de l'expression régulière spécifiée, directement depuis son analyse syntaxique.
+ *
+ * Remarque:
+ * - L'automate possède `m + 1` états et au plus `(m + 1) * m` transitions, où `m` est le nombre de symboles de l'expression.
+ */
+Glushkov glushkov_compiler(const char *s) {
+	Construction C;
+	C.m = 0;
+	C.capacity = 16;
+	C.symbole = checked_malloc(C.capacity * sizeof(char));
+	C.follow = checked_malloc(C.capacity * sizeof(set));
+	C.pile = NULL;
+	C.len = 0;
+	C.lenCapacity = 0;
+	
+	C.symbole[0] = '\0';
+	
+	Actions actions = { &C, glushkov_symbole, glushkov_unir, glushkov_concatener, glushkov_etoile };
+	analyser(s, &actions);
+	
+	Noeud N = construction_depiler(&C);
+	free(C.pile);
+	
+	Glushkov G = checked_malloc(sizeof(struct Glushkov));
+	G->m = C.m;
+	G->symbole = C.symbole;
+	G->follow = C.follow;
+	G->nullable = N.nullable;
+	G->first = N.first;
+	G->last = N.last;
+	
+	// l'état initial est suivi des débuts de l'expression
+	G->follow[0] = set_union(N.first, set_new_empty());
+	
+	G->parallele = G->m <= GLUSHKOV_POSITIONS_MAX;
+	G->suivants = NULL;
+	G->nbTables = 0;
+	G->B = NULL;
+	
+	if(G->parallele) {
+		glushkov_compiler_masques(G);
+	}
+	else {
+		AFN A = glushkov_construire_afn(G);
+		G->B = afnb_compiler(A);
+		afn_free(A);
+	}
+	
+	return G;
+}
+
+
+/**
+ * Renvoie une copie de l'automate des positions sous forme d'AFN sans epsilon-transition (`Q = m`).
+ */
+AFN glushkov_afn(Glushkov G) {
+	return glushkov_construire_afn(G);
+}
+
+
+/**
+ * Renvoie `1` si les `n` premiers octets de `s` forment un mot accepté par l'automate spécifié, sinon renvoie `0`.
+ */
+int glushkov_simuler_n(Glushkov G, const char *s, size_t n) {
+	if(!G->parallele) {
+		// `afnb_simuler()` lit une chaîne terminée par '\0'
+		char *copie = checked_malloc(n + 1);
+		memcpy(copie, s, n);
+		copie[n] = '\0';
+		
+		int r = (memchr(s, '\0', n) == NULL) && afnb_simuler(G->B, copie);
+		free(copie);
+		
+		return r;
+	}
+	
+	const uint64_t (*suivants)[256] = (const uint64_t (*)[256]) G->suivants;
+	const int nbTables = G->nbTables;
+	
+	uint64_t D = 1;
+	for(size_t i = 0; i < n; ++i) {
+		uint64_t S = 0;
+		for(int k = 0; k < nbTables; ++k) {
+			S |= suivants[k][(D >> (8 * k)) & 0xFF];
+		}
+		
+		D = S & G->masque[(unsigned char) s[i]];
+		if(D == 0) {
+			return 0;
+		}
+	}
+	
+	return (D & G->finals) != 0;
+}
+
+
+/**
+ * Renvoie `1` si la chaîne spécifiée est acceptée par l'automate spécifié, sinon renvoie `0`.
+ */
+int glushkov_simuler(Glushkov G, const char *s) {
+	if(!G->parallele) {
+		return afnb_simuler(G->B, s);
+	}
+	
+	return glushkov_simuler_n(G, s, strlen(s));
+}
+
+
+/**
+ * Libère les ressources allouées à un automate des positions.
+ */
+void glushkov_free(Glushkov G) {
+	for(int p = 0; p <= G->m; ++p) {
+		set_free(&G->follow[p]);
+	}
+	
+	free(G->follow);
+	free(G->symbole);
+	set_free(&G->first);
+	set_free(&G->last);
+	free(G->suivants);
+	
+	if(G->B != NULL) {
+		afnb_free(G->B);
+	}
+	
+	free(G);
+}
@@ -0,0 +1,124 @@
+#ifndef GLUSHKOV_H
+#define GLUSHKOV_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "afn.h"
+#include "afnb.h"
+#include "util/set.h"
+
+/**
+ * Le nombre de positions au-delà duquel la simulation bit-parallèle n'est plus possible :
+ * les positions et l'état initial doivent tenir dans un seul mot de 64 bits.
+ */
+#define GLUSHKOV_POSITIONS_MAX 63
+
+
+/**
+ * Représente l'automate des positions (de Glushkov) d'une expression régulière.
+ *
+ * Chaque occurrence d'un symbole dans l'expression est une position, numérotée de `1` à `m` de gauche à droite ;
+ * l'état `0` est l'état initial. L'automate ne possède aucune epsilon-transition : il passe de la position `p`
+ * (ou de `0`) à la position `p'` en lisant `symbole[p']` si `p'` appartient à `follow[p]` (ou à `first`).
+ *
+ * Lorsque `m <= GLUSHKOV_POSITIONS_MAX`, un ensemble d'états est un mot de 64 bits (l'état `q` étant le bit `q`)
+ * et une étape de simulation se réduit à `D' = suivants(D) & masque[c]`, à la manière de l'algorithme Shift-And.
+ * Au-delà, l'automate est simulé par `afnb_simuler()`.
+ */
+struct Glushkov {
+	/**
+	 * Le nombre de positions.
+	 */
+	int m;
+	
+	/**
+	 * `symbole[p]` est le symbole de la position `p`, pour `1 <= p <= m`.
+	 */
+	char *symbole;
+	
+	/**
+	 * `1` si le mot vide appartient au langage, sinon `0`.
+	 */
+	int nullable;
+	
+	/**
+	 * Les positions par lesquelles un mot du langage peut commencer.
+	 */
+	set first;
+	
+	/**
+	 * Les positions par lesquelles un mot du langage peut se terminer.
+	 */
+	set last;
+	
+	/**
+	 * `follow[p]` : les positions pouvant suivre la position `p`, pour `1 <= p <= m` ; `follow[0]` vaut `first`.
+	 */
+	set *follow;
+	
+	/**
+	 * `1` si la simulation bit-parallèle est utilisée, c.-à-d. si `m <= GLUSHKOV_POSITIONS_MAX`.
+	 */
+	int parallele;
+	
+	/**
+	 * `masque[c]` : les positions dont le symbole est l'octet `c`.
+	 */
+	uint64_t masque[256];
+	
+	/**
+	 * `suivants[k][v]` : l'union des `follow[q]` pour les états `q = 8k + i` tels que le bit `i` de `v` vaut `1`.
+	 * Seules les `nbTables` premières tables sont utilisées.
+	 */
+	uint64_t (*suivants)[256];
+	
+	/**
+	 * Le nombre de tables de `suivants`, c.-à-d. `ceil((m + 1) / 8)`.
+	 */
+	int nbTables;
+	
+	/**
+	 * Les états finaux : les positions de `last`, et l'état `0` si `nullable`.
+	 */
+	uint64_t finals;
+	
+	/**
+	 * L'automate des positions compilé en ensembles de bits de plusieurs mots, simulé lorsque `parallele` vaut `0`.
+	 */
+	AFNB B;
+};
+
+typedef struct Glushkov* Glushkov;
+
+
+/**
+ * Construit l'automate des positions de l'expression régulière spécifiée, directement depuis son analyse syntaxique.
+ */
+Glushkov glushkov_compiler(const char *s);
+
+
+/**
+ * Renvoie une copie de l'automate des positions sous forme d'AFN sans epsilon-transition (`Q = m`).
+ */
+AFN glushkov_afn(Glushkov G);
+
+
+/**
+ * Renvoie `1` si les `n` premiers octets de `s` forment un mot accepté par l'automate spécifié, sinon renvoie `0`.
+ */
+int glushkov_simuler_n(Glushkov G, const char *s, size_t n);
+
+
+/**
+ * Renvoie `1` si la chaîne spécifiée est acceptée par l'automate spécifié, sinon renvoie `0`.
+ */
+int glushkov_simuler(Glushkov G, const char *s);
+
+
+/**
+ * Libère les ressources allouées à un automate des positions.
+ */
+void glushkov_free(Glushkov G);
+
+#endif // GLUSHKOV_H
@@ -0,0 +1,190 @@
+#include "multi.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "afn.h"
+#include "compregex.h"
+#include "util/misc.h"
+#include "util/stack.h"
+
+/**
+ * Compile les `n` expressions régulières spécifiées en un seul automate ; le motif d'indice `i` est `motifs[i]`.
+ *
+ * Paramètres:
+ * - recherche: `1` pour rechercher les motifs n'importe où dans la chaîne, `0` pour qu'ils la reconnaissent entièrement
+ */
+Multi multi_compiler(const char **motifs, int n, int recherche) {
+	check_param("n", n > 0);
+	
+	AFN *automates = checked_malloc(n * sizeof(AFN));
+	int *decalages = checked_malloc(n * sizeof(int));
+	
+	for(int i = 0; i < n; ++i) {
+		automates[i] = compile(motifs[i]);
+	}
+	
+	AFN U = afn_union_multiple(automates, n, decalages);
+	
+	// `motif[q]` : l'indice du motif dont l'état `q` de l'union est final, ou `-1` ;
+	// l'état ajouté par `afn_prefixer()` (`U->Q + 1`) n'est jamais final
+	int *motif = checked_malloc((U->Q + 2) * sizeof(int));
+	for(int q = 0; q <= U->Q + 1; ++q) {
+		motif[q] = -1;
+	}
+	
+	for(int i = 0; i < n; ++i) {
+		for(int j = 0; j < automates[i]->lenF; ++j) {
+			motif[automates[i]->F[j] + decalages[i]] = i;
+		}
+		
+		afn_free(automates[i]);
+	}
+	
+	free(automates);
+	free(decalages);
+	
+	if(recherche) {
+		AFN P = afn_prefixer(U);
+		afn_free(U);
+		U = P;
+	}
+	
+	setmap etats = setmap_new_empty();
+	AFD D = afn_determiniser_etats(U, &etats);
+	
+	Multi M = checked_malloc(sizeof(struct Multi));
+	M->nbMotifs = n;
+	M->recherche = recherche;
+	M->T = recherche ? afdc_compiler_recherche(D) : afdc_compiler(D);
+	
+	// étiquettes de chaque état de l'AFD : les états de l'union étant numérotés motif après motif,
+	// parcourir un ensemble trié donne des indices de motifs déjà croissants
+	M->debut = checked_malloc((etats.len + 1) * sizeof(int));
+	stack etiquettes = stack_new_empty();
+	
+	for(size_t d = 0; d < etats.len; ++d) {
+		M->debut[d] = (int) etiquettes.len;
+		
+		set E = etats.cles[d];
+		for(size_t k = 0; k < E.len; ++k) {
+			int m = motif[E.buf[k]];
+			
+			if(m != -1 && (etiquettes.len == (size_t) M->debut[d] || stack_peek(etiquettes) != m)) {
+				stack_push(&etiquettes, m);
+			}
+		}
+	}
+	
+	M->debut[etats.len] = (int) etiquettes.len;
+	M->motifs = etiquettes.buf;  // vaut `NULL` si aucun état n'est final
+	
+	M->vu = checked_malloc(n * sizeof(int));
+	for(int i = 0; i < n; ++i) {
+		M->vu[i] = -1;
+	}
+	M->marque = 0;
+	
+	setmap_free(&etats);
+	afd_free(D);
+	afn_free(U);
+	free(motif);
+	return M;
+}
+
+
+/**
+ * Ajoute à `resultats` les motifs de l'état prémultiplié `q` qui n'y sont pas déjà, et renvoie le nouveau nombre de résultats.
+ */
+static int multi_ajouter(Multi M, int q, int *resultats, int len) {
+	int d = q / M->T->nbColonnes;
+	
+	for(int k = M->debut[d]; k < M->debut[d + 1]; ++k) {
+		int m = M->motifs[k];
+		
+		if(M->vu[m] != M->marque) {
+			M->vu[m] = M->marque;
+			resultats[len++] = m;
+		}
+	}
+	
+	return len;
+}
+
+
+/**
+ * Compare deux entiers pour `qsort()`.
+ */
+static int int_cmp(const void *lhs, const void *rhs) {
+	int a = *(const int*) lhs;
+	int b = *(const int*) rhs;
+	
+	return (a > b) - (a < b);
+}
+
+
+/**
+ * Simule l'automate sur les `n` premiers octets de `s`, écrit les indices des motifs reconnus dans `resultats`
+ * (de taille `M->nbMotifs`) par ordre croissant, et renvoie leur nombre.
+ *
+ * Remarque:
+ * - Un même `Multi` ne doit pas être utilisé simultanément par plusieurs threads.
+ */
+int multi_executer(Multi M, const char *s, size_t n, ModeMulti mode, int *resultats) {
+	const AFDC T = M->T;
+	
+	if(!M->recherche) {
+		// reconnaissance de la chaîne entière : seul le dernier état compte
+		int q = T->q0;
+		for(size_t i = 0; i < n; ++i) {
+			q = T->delta[q + T->colonne[(unsigned char) s[i]]];
+		}
+		
+		if(!T->finals[q]) {
+			return 0;
+		}
+		
+		int d = q / T->nbColonnes;
+		int len = (mode == MULTI_PREMIER) ? 1 : (M->debut[d + 1] - M->debut[d]);
+		
+		memcpy(resultats, &M->motifs[M->debut[d]], len * sizeof(int));
+		return len;
+	}
+	
+	// recherche : chaque état final rencontré ajoute ses motifs, le premier suffisant en mode `MULTI_PREMIER`
+	++M->marque;
+	
+	int len = 0;
+	int q = T->q0;
+	
+	if(T->finals[q]) {
+		len = multi_ajouter(M, q, resultats, len);
+	}
+	
+	for(size_t i = 0; i < n && !(mode == MULTI_PREMIER && len > 0) && len < M->nbMotifs; ++i) {
+		q = T->delta[q + T->colonne[(unsigned char) s[i]]];
+		
+		if(T->finals[q]) {
+			len = multi_ajouter(M, q, resultats, len);
+		}
+	}
+	
+	if(mode == MULTI_PREMIER) {
+		return len > 0 ? 1 : 0;
+	}
+	
+	qsort(resultats, len, sizeof(int), int_cmp);
+	return len;
+}
+
+
+/**
+ * Libère les ressources allouées à un ensemble de motifs.
+ */
+void multi_free(Multi M) {
+	afdc_free(M->T);
+	free(M->debut);
+	free(M->motifs);
+	free(M->vu);
+	free(M);
+}
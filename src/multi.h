@@ -0,0 +1,86 @@
+#ifndef MULTI_H
+#define MULTI_H
+
+#include <stddef.h>
+
+#include "afdc.h"
+
+/**
+ * Le mode de `multi_executer()`.
+ */
+typedef enum {
+	/**
+	 * Seul le premier motif reconnu est renvoyé : en recherche, celui dont l'occurrence se termine le plus tôt,
+	 * et parmi eux celui d'indice le plus petit.
+	 */
+	MULTI_PREMIER,
+	
+	/**
+	 * Tous les motifs reconnus sont renvoyés.
+	 */
+	MULTI_TOUS
+} ModeMulti;
+
+
+/**
+ * Représente un ensemble de motifs compilés en un seul automate, dont chaque état final est étiqueté
+ * par les indices des motifs qu'il reconnaît : une seule lecture de la chaîne suffit pour tous les motifs.
+ */
+struct Multi {
+	/**
+	 * Le nombre de motifs.
+	 */
+	int nbMotifs;
+	
+	/**
+	 * `1` si les motifs sont recherchés n'importe où dans la chaîne, `0` s'ils doivent la reconnaître entièrement.
+	 */
+	int recherche;
+	
+	/**
+	 * La table de transition de l'automate combiné.
+	 */
+	AFDC T;
+	
+	/**
+	 * Les motifs reconnus par l'état d'indice `d` (c.-à-d. prémultiplié `d * T->nbColonnes`) sont
+	 * `motifs[debut[d]]` ... `motifs[debut[d + 1] - 1]`, triés par ordre croissant.
+	 */
+	int *debut;
+	int *motifs;
+	
+	/**
+	 * `vu[m] == marque` si le motif `m` a déjà été renvoyé par l'appel en cours de `multi_executer()`.
+	 */
+	int *vu;
+	int marque;
+};
+
+typedef struct Multi* Multi;
+
+
+/**
+ * Compile les `n` expressions régulières spécifiées en un seul automate ; le motif d'indice `i` est `motifs[i]`.
+ *
+ * Paramètres:
+ * - recherche: `1` pour rechercher les motifs n'importe où dans la chaîne, `0` pour qu'ils la reconnaissent entièrement
+ */
+Multi multi_compiler(const char **motifs, int n, int recherche);
+
+
+/**
+ * Simule l'automate sur les `n` premiers octets de `s`, écrit les indices des motifs reconnus dans `resultats`
+ * (de taille `M->nbMotifs`) par ordre croissant, et renvoie leur nombre.
+ *
+ * Remarque:
+ * - Un même `Multi` ne doit pas être utilisé simultanément par plusieurs threads.
+ */
+int multi_executer(Multi M, const char *s, size_t n, ModeMulti mode, int *resultats);
+
+
+/**
+ * Libère les ressources allouées à un ensemble de motifs.
+ */
+void multi_free(Multi M);
+
+#endif // MULTI_H
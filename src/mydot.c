@@ -1,12 +1,49 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
 
+#include "ast.h"
 #include "compregex.h"
 #include "util/misc.h"
 
+/**
+ * Affiche l'arbre syntaxique de l'expression spécifiée, avant puis après simplification.
+ */
+static void afficher_ast(const char *s) {
+	Ast T = ast_analyser(s);
+	char *avant = ast_expression(T);
+	
+	printf("%s\navant simplification (%d symboles) : %s\n", s, ast_nb_symboles(T), avant);
+	ast_print(T);
+	
+	T = ast_simplifier(T);
+	char *apres = ast_expression(T);
+	
+	printf("après simplification (%d symboles) : %s\n", ast_nb_symboles(T), apres);
+	ast_print(T);
+	printf("\n");
+	
+	free(avant);
+	free(apres);
+	ast_free(T);
+}
+
+
 int main(int argc, char *argv[]) {
-	if(argc < 2) {
-		fprintf(stderr, "%s <expression régulière...>\n", argv[0]);
+	int arbre = 0;
+	
+	int c;
+	while((c = getopt(argc, argv, "a")) != -1) {
+		switch(c) {
+			case 'a': arbre = 1; break;
+			default:
+				fprintf(stderr, "%s [-a] <expression régulière...>\n", argv[0]);
+				exit(1);
+		}
+	}
+	
+	if(optind >= argc) {
+		fprintf(stderr, "%s [-a] <expression régulière...>\n", argv[0]);
 		exit(1);
 	}
 	
@@ -15,9 +52,13 @@ int main(int argc, char *argv[]) {
 		fprintf(stderr, "avertissement: impossible de supprimer les anciens dessins (%i)\n", retcode);
 	}
 	
-	for(int i = 1; i < argc; ++i) {
+	for(int i = optind; i < argc; ++i) {
 		char filename[16]; // len("param") + ceil(log10(2^31)) + len('\0')
-		snprintf(&filename[0], 16, "param%i", i - 1);
+		snprintf(&filename[0], 16, "param%i", i - optind);
+		
+		if(arbre) {
+			afficher_ast(argv[i]);
+		}
 		
 		AFN A = compile(argv[i]);
 		afn_dot(A, &filename[0]);
@@ -26,4 +67,3 @@ int main(int argc, char *argv[]) {
 	
 	printf("Toutes les expressions régulières ont été dessinées.\n");
 }
-
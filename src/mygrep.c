@@ -1,23 +1,315 @@
+#define _GNU_SOURCE  // memmem(), memrchr()
+
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
+#include "afdc.h"
 #include "compregex.h"
+#include "recherche.h"
+#include "util/misc.h"
+#include "util/stats.h"
+
+/**
+ * La taille initiale du tampon de lecture ; il est agrandi si une ligne ne tient pas dedans.
+ */
+#define TAILLE_LECTURE (1 << 20)
+
+/**
+ * La taille du tampon de la sortie standard.
+ */
+#define TAILLE_ECRITURE (1 << 16)
+
+
+/**
+ * Représente les options de la ligne de commande.
+ */
+typedef struct {
+	/**
+	 * `1` pour n'afficher que le nombre de lignes acceptées (`-c`).
+	 */
+	int compter;
+	
+	/**
+	 * `1` pour ne rien afficher et s'arrêter à la première ligne acceptée (`-q`).
+	 */
+	int silencieux;
+	
+	/**
+	 * `1` pour n'accepter que les lignes entièrement reconnues par l'expression (`-x`).
+	 */
+	int ligne;
+	
+	/**
+	 * `1` pour préfixer chaque ligne par la position de la première occurrence, `début-fin:` (`-b`).
+	 */
+	int positions;
+	
+	/**
+	 * `1` pour dessiner l'AFN dans `out/png/grep.png` (`-d`).
+	 */
+	int dessiner;
+	
+	/**
+	 * `1` pour préfixer chaque ligne par le nom de son fichier (plusieurs fichiers).
+	 */
+	int prefixer;
+	
+	/**
+	 * `1` pour afficher les compteurs d'instrumentation sur la sortie d'erreur à la fin (`-s`, voir `util/stats.h`).
+	 */
+	int statistiques;
+} Options;
+
+
+/**
+ * Représente un tampon de lecture partagé par tous les fichiers.
+ */
+typedef struct {
+	char *buf;
+	size_t capacity;
+} Tampon;
+
+
+/**
+ * Représente l'automate simulé sur chaque ligne : une table complète (`-x`) ou un automate de recherche.
+ */
+typedef struct {
+	AFDC T;
+	Recherche R;
+	
+	/**
+	 * Le littéral le plus rare que toute ligne acceptée contient, ou `NULL`.
+	 */
+	const char *litteral;
+	size_t lenLitteral;
+} Automate;
+
+
+/**
+ * Renvoie `1` si la ligne `s` de `n` octets est acceptée, et écrit la position de la première occurrence
+ * dans `[*debut, *fin)`.
+ */
+static int accepter(const Automate *M, const char *s, size_t n, long *debut, long *fin) {
+	if(M->T != NULL) {
+		*debut = 0;
+		*fin = (long) n;
+		return afdc_simuler_n(M->T, s, n);
+	}
+	
+	*fin = recherche_executer(M->R, s, n, debut);
+	return *fin != -1;
+}
+
+
+/**
+ * Lit le fichier `fd` par gros blocs et simule l'automate sur chacune de ses lignes (sans le '\n').
+ * Renvoie le nombre de lignes acceptées ; en mode silencieux, la lecture s'arrête à la première.
+ * `*erreur` est mis à `1` si la lecture échoue.
+ */
+static long grep_fd(int fd, const char *nom, const Automate *M, const Options *opt, Tampon *t, int *erreur) {
+	long compte = 0;
+	size_t len = 0;
+	
+	while(1) {
+		ssize_t r = read(fd, t->buf + len, t->capacity - len);
+		if(r < 0) {
+			perror(nom);
+			*erreur = 1;
+			return compte;
+		}
+		
+		const int fin = (r == 0);
+		len += r;
+		
+		char *debut = t->buf;
+		char *end = t->buf + len;
+		
+		while(debut != end) {
+			if(M->litteral != NULL) {
+				// les lignes précédant la prochaine occurrence du littéral ne peuvent pas être acceptées
+				char *occ = memmem(debut, end - debut, M->litteral, M->lenLitteral);
+				char *avant = memrchr(debut, '\n', ((occ != NULL) ? occ : end) - debut);
+				
+				if(avant != NULL) {
+					debut = avant + 1;
+				}
+				
+				if(occ == NULL) {
+					// seule la ligne incomplète, s'il y en a une, est conservée pour la lecture suivante
+					if(fin) {
+						debut = end;
+					}
+					
+					break;
+				}
+			}
+			
+			char *nl = memchr(debut, '\n', end - debut);
+			if(nl == NULL) {
+				if(!fin) {
+					break;
+				}
+				
+				// dernière ligne sans '\n'
+				nl = end;
+			}
+			
+			long d, f;
+			if(accepter(M, debut, nl - debut, &d, &f)) {
+				++compte;
+				
+				if(opt->silencieux) {
+					return compte;
+				}
+				
+				if(!opt->compter) {
+					if(opt->prefixer) {
+						fputs(nom, stdout);
+						putchar(':');
+					}
+					
+					if(opt->positions) {
+						printf("%ld-%ld:", d, f);
+					}
+					
+					fwrite(debut, 1, nl - debut, stdout);
+					putchar('\n');
+				}
+			}
+			
+			debut = (nl == end) ? end : (nl + 1);
+		}
+		
+		if(fin) {
+			return compte;
+		}
+		
+		// la ligne incomplète est ramenée au début du tampon, agrandi si elle le remplit entièrement
+		len = end - debut;
+		memmove(t->buf, debut, len);
+		
+		if(len == t->capacity) {
+			t->capacity *= 2;
+			t->buf = checked_realloc(t->buf, t->capacity);
+		}
+	}
+}
+
 
 int main(int argc, char *argv[]) {
-	if(argc != 3) {
-		fprintf(stderr, "%s <expression régulière> <chaîne à tester>\n", argv[0]);
-		exit(1);
+	Options opt = { 0, 0, 0, 0, 0, 0, 0 };
+	
+	int c;
+	while((c = getopt(argc, argv, "cqxbds")) != -1) {
+		switch(c) {
+			case 'c': opt.compter = 1; break;
+			case 'q': opt.silencieux = 1; break;
+			case 'x': opt.ligne = 1; break;
+			case 'b': opt.positions = 1; break;
+			case 'd': opt.dessiner = 1; break;
+			case 's': opt.statistiques = 1; break;
+			default:
+				fprintf(stderr, "%s [-c] [-q] [-x] [-b] [-d] [-s] <expression régulière> [fichier...]\n", argv[0]);
+				exit(2);
+		}
+	}
+	
+	if(optind >= argc) {
+		fprintf(stderr, "%s [-c] [-q] [-x] [-b] [-d] [-s] <expression régulière> [fichier...]\n", argv[0]);
+		exit(2);
 	}
 	
-	AFN A = compile(argv[1]);
-	afn_dot(A, "grep");
+	// comme `grep`, une expression invalide n'est pas confondue avec l'absence de ligne acceptée
+	compregex_code_erreur = 2;
 	
-	if(afn_simuler(A, argv[2])) {
-		printf("\"%s\" est acceptée\n", argv[2]);
+	const char *motif = argv[optind++];
+	AFN A = compile(motif);
+	if(opt.dessiner) {
+		afn_dot(A, "grep");
+	}
+	
+	// une seule consultation de table par octet lu
+	Automate M = { NULL, NULL, NULL, 0 };
+	if(opt.ligne) {
+		AFD D = afn_determiniser(A);
+		M.T = afdc_compiler(D);
+		afd_free(D);
 	}
 	else {
-		printf("\"%s\" est rejetée\n", argv[2]);
+		M.R = recherche_compiler(A);
 	}
 	
 	afn_free(A);
+	
+	// préfiltre : les lignes ne contenant pas le littéral obligatoire le plus rare ne sont jamais simulées
+	Litteraux L = litteraux_extraire(motif);
+	M.litteral = litteraux_plus_rare(&L);
+	M.lenLitteral = (M.litteral != NULL) ? strlen(M.litteral) : 0;
+	
+	static char sortie[TAILLE_ECRITURE];
+	setvbuf(stdout, sortie, _IOFBF, sizeof(sortie));
+	
+	Tampon t;
+	t.capacity = TAILLE_LECTURE;
+	t.buf = checked_malloc(t.capacity);
+	
+	const int nbFichiers = argc - optind;
+	opt.prefixer = nbFichiers > 1;
+	
+	long total = 0;
+	int erreur = 0;
+	
+	for(int i = 0; i < (nbFichiers > 0 ? nbFichiers : 1); ++i) {
+		const char *nom = (nbFichiers > 0) ? argv[optind + i] : "-";
+		int fd = (strcmp(nom, "-") == 0) ? STDIN_FILENO : open(nom, O_RDONLY);
+		
+		if(fd < 0) {
+			fprintf(stderr, "fichier inaccessible: %s\n", nom);
+			erreur = 1;
+			continue;
+		}
+		
+		long compte = grep_fd(fd, nom, &M, &opt, &t, &erreur);
+		total += compte;
+		
+		if(fd != STDIN_FILENO) {
+			close(fd);
+		}
+		
+		if(opt.silencieux && compte > 0) {
+			break;
+		}
+		
+		if(opt.compter) {
+			if(opt.prefixer) {
+				printf("%s:", nom);
+			}
+			
+			printf("%ld\n", compte);
+		}
+	}
+	
+	fflush(stdout);
+	if(opt.statistiques) {
+		stats_afficher(stderr);
+	}
+	
+	free(t.buf);
+	litteraux_free(&L);
+	if(M.T != NULL) {
+		afdc_free(M.T);
+	}
+	else {
+		recherche_free(M.R);
+	}
+	
+	// même convention que grep : 0 si au moins une ligne est acceptée, 1 sinon, 2 en cas d'erreur
+	if(erreur && !(opt.silencieux && total > 0)) {
+		return 2;
+	}
+	
+	return total > 0 ? 0 : 1;
 }
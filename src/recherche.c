@@ -0,0 +1,83 @@
+#define _GNU_SOURCE  // memmem()
+
+#include "recherche.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "util/misc.h"
+
+/**
+ * Compile un automate de recherche du langage de l'AFN spécifié ; l'AFN peut être libéré ensuite.
+ */
+Recherche recherche_compiler(AFN A) {
+	Recherche R = checked_malloc(sizeof(struct Recherche));
+	
+	AFN P = afn_prefixer(A);
+	AFD D = afn_determiniser(P);
+	R->avant = afdc_compiler_recherche(D);
+	afd_free(D);
+	afn_free(P);
+	
+	AFN M = afn_inverser(A);
+	D = afn_determiniser(M);
+	R->arriere = afdc_compiler(D);
+	afd_free(D);
+	afn_free(M);
+	
+	R->litteral = NULL;
+	R->lenLitteral = 0;
+	
+	return R;
+}
+
+
+/**
+ * Indique à l'automate de recherche un littéral que toute occurrence contient (voir `litteraux_plus_rare()`) :
+ * les chaînes qui ne le contiennent pas sont rejetées sans simuler les tables.
+ */
+void recherche_prefiltrer(Recherche R, const char *litteral) {
+	free(R->litteral);
+	R->litteral = NULL;
+	R->lenLitteral = 0;
+	
+	if(litteral != NULL && *litteral != '\0') {
+		R->lenLitteral = strlen(litteral);
+		R->litteral = checked_malloc(R->lenLitteral + 1);
+		memcpy(R->litteral, litteral, R->lenLitteral + 1);
+	}
+}
+
+
+/**
+ * Recherche la première occurrence du langage dans les `n` premiers octets de `s`.
+ *
+ * Renvoie la position de fin (exclue) de la première occurrence, c.-à-d. celle qui se termine le plus tôt,
+ * ou `-1` s'il n'y en a aucune. Si `debut` n'est pas `NULL`, la position du début le plus à gauche d'une
+ * occurrence se terminant à cette même position y est écrite.
+ */
+long recherche_executer(Recherche R, const char *s, size_t n, long *debut) {
+	if(R->litteral != NULL && memmem(s, n, R->litteral, R->lenLitteral) == NULL) {
+		return -1;
+	}
+	
+	long fin = afdc_rechercher(R->avant, s, n);
+	
+	if(fin != -1 && debut != NULL) {
+		// une occurrence se termine en `fin`, le miroir de L accepte donc au moins un suffixe de `s[0..fin)`
+		*debut = fin - afdc_rechercher_arriere(R->arriere, s, (size_t) fin);
+	}
+	
+	return fin;
+}
+
+
+/**
+ * Libère les ressources allouées à un automate de recherche.
+ */
+void recherche_free(Recherche R) {
+	afdc_free(R->avant);
+	afdc_free(R->arriere);
+	free(R->litteral);
+	free(R);
+}
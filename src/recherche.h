@@ -0,0 +1,69 @@
+#ifndef RECHERCHE_H
+#define RECHERCHE_H
+
+#include <stddef.h>
+
+#include "afdc.h"
+#include "afn.h"
+
+/**
+ * Représente un automate de recherche : il trouve les occurrences d'un langage L n'importe où dans un texte,
+ * en une seule lecture linéaire.
+ *
+ * La table `avant` reconnaît Σ*L : elle s'arrête à la fin de la première occurrence. La table `arriere`
+ * reconnaît le miroir de L : relue à partir de cette fin, elle en retrouve le début le plus à gauche.
+ */
+struct Recherche {
+	/**
+	 * La table de recherche de Σ*L.
+	 */
+	AFDC avant;
+	
+	/**
+	 * La table du miroir de L.
+	 */
+	AFDC arriere;
+	
+	/**
+	 * Un littéral que toute occurrence contient, cherché avant de simuler les tables, ou `NULL`.
+	 */
+	char *litteral;
+	
+	/**
+	 * La longueur de `litteral`.
+	 */
+	size_t lenLitteral;
+};
+
+typedef struct Recherche* Recherche;
+
+
+/**
+ * Compile un automate de recherche du langage de l'AFN spécifié ; l'AFN peut être libéré ensuite.
+ */
+Recherche recherche_compiler(AFN A);
+
+
+/**
+ * Indique à l'automate de recherche un littéral que toute occurrence contient (voir `litteraux_plus_rare()`) :
+ * les chaînes qui ne le contiennent pas sont rejetées sans simuler les tables.
+ */
+void recherche_prefiltrer(Recherche R, const char *litteral);
+
+
+/**
+ * Recherche la première occurrence du langage dans les `n` premiers octets de `s`.
+ *
+ * Renvoie la position de fin (exclue) de la première occurrence, c.-à-d. celle qui se termine le plus tôt,
+ * ou `-1` s'il n'y en a aucune. Si `debut` n'est pas `NULL`, la position du début le plus à gauche d'une
+ * occurrence se terminant à cette même position y est écrite.
+ */
+long recherche_executer(Recherche R, const char *s, size_t n, long *debut);
+
+
+/**
+ * Libère les ressources allouées à un automate de recherche.
+ */
+void recherche_free(Recherche R);
+
+#endif // RECHERCHE_H
@@ -1,8 +1,25 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include "afd.h"
+#include "afdc.h"
+#include "afdp.h"
 #include "afn.h"
+#include "afnb.h"
+#include "ast.h"
+#include "binaire.h"
+#include "cache.h"
+#include "chargeur.h"
 #include "compregex.h"
+#include "derivee.h"
+#include "glushkov.h"
+#include "multi.h"
+#include "recherche.h"
+#include "util/misc.h"
+#include "util/stats.h"
 
 #define print(expr)  \
 printf(#expr ";\n"); \
@@ -21,6 +38,129 @@ else {                                                                         \
 #define assert_accepted(A, s) assert_simul(A, s, 1, "accepted")
 #define assert_rejected(A, s) assert_simul(A, s, 0, "rejected")
 
+#define assert_recherche(R, s, d, f)                                                               \
+{                                                                                                  \
+	long _debut = -1;                                                                              \
+	long _fin = recherche_executer(R, s, strlen(s), &_debut);                                      \
+	if(_fin != f || (f != -1 && _debut != d)) {                                                    \
+		fprintf(stderr, "assert failed: \"" s "\" is not found at [" #d ", " #f ") by " #R "\n");  \
+	}                                                                                              \
+	else {                                                                                         \
+		printf("assert ok: \"" s "\" is found at [" #d ", " #f ") by " #R "\n");                   \
+	}                                                                                              \
+}
+
+#define assert_litteral(motif, attendu)                                                          \
+{                                                                                                \
+	Litteraux _L = litteraux_extraire(motif);                                                    \
+	const char *_rare = litteraux_plus_rare(&_L);                                                \
+	const char *_attendu = attendu;                                                              \
+	if(_rare == NULL ? _attendu != NULL : (_attendu == NULL || strcmp(_rare, _attendu) != 0)) {  \
+		fprintf(stderr, "assert failed: \"" motif "\" does not require " #attendu "\n");         \
+	}                                                                                            \
+	else {                                                                                       \
+		printf("assert ok: \"" motif "\" requires " #attendu "\n");                              \
+	}                                                                                            \
+	litteraux_free(&_L);                                                                         \
+}
+
+#define assert_ast(motif, attendu)                                                               \
+{                                                                                                \
+	Ast _T = ast_simplifier(ast_analyser(motif));                                                \
+	char *_simplifie = ast_expression(_T);                                                       \
+	if(strcmp(_simplifie, attendu) != 0) {                                                       \
+		fprintf(stderr, "assert failed: \"" motif "\" is not simplified to \"" attendu "\"\n");  \
+	}                                                                                            \
+	else {                                                                                       \
+		printf("assert ok: \"" motif "\" is simplified to \"" attendu "\"\n");                   \
+	}                                                                                            \
+	free(_simplifie);                                                                            \
+	ast_free(_T);                                                                                \
+}
+
+#define assert_erreur(expr, code, attendu)                                                       \
+{                                                                                                \
+	int _tube[2];                                                                                \
+	char _erreur[1024];                                                                          \
+	pid_t _pid = lancer_fils(_tube);                                                             \
+	if(_pid == 0) {                                                                              \
+		expr;                                                                                    \
+		exit(0);                                                                                 \
+	}                                                                                            \
+	int _code = attendre_fils(_pid, _tube, _erreur, sizeof(_erreur));                           \
+	if(_code != code || strstr(_erreur, attendu) == NULL) {                                      \
+		fprintf(stderr, "assert failed: " #expr " does not exit(" #code ") with \"" attendu "\"\n");  \
+	}                                                                                            \
+	else {                                                                                       \
+		printf("assert ok: " #expr " exits(" #code ") with \"" attendu "\"\n");                   \
+	}                                                                                            \
+}
+
+/**
+ * La taille des textes de la simulation parallèle : 4 morceaux de 256 Kio.
+ */
+#define TAILLE_TEXTE_LONG (1 << 20)
+
+/**
+ * Écrit dans `texte` le mot `debut` suivi de `b` jusqu'à `TAILLE_TEXTE_LONG` octets, et renvoie cette taille.
+ */
+static size_t texte_long(char *texte, const char *debut) {
+	size_t n = strlen(debut);
+	memcpy(texte, debut, n);
+	memset(texte + n, 'b', TAILLE_TEXTE_LONG - n);
+	
+	return TAILLE_TEXTE_LONG;
+}
+
+/**
+ * Crée un processus fils dont la sortie d'erreur est redirigée dans le tube `tube`, et renvoie son identifiant
+ * dans le père ou `0` dans le fils.
+ */
+static pid_t lancer_fils(int tube[2]) {
+	fflush(stdout);
+	fflush(stderr);
+	
+	if(pipe(tube) != 0) {
+		perror("pipe");
+		exit(1);
+	}
+	
+	pid_t pid = fork();
+	if(pid == -1) {
+		perror("fork");
+		exit(1);
+	}
+	
+	if(pid == 0) {
+		close(tube[0]);
+		dup2(tube[1], STDERR_FILENO);
+		close(tube[1]);
+	}
+	
+	return pid;
+}
+
+/**
+ * Recopie dans `erreur` (de taille `n`, terminée par '\0') la sortie d'erreur du fils `pid`, attend sa fin,
+ * et renvoie son code de sortie, ou `-1` s'il a été tué par un signal.
+ */
+static int attendre_fils(pid_t pid, int tube[2], char *erreur, size_t n) {
+	close(tube[1]);
+	
+	size_t len = 0;
+	ssize_t r;
+	while(len + 1 < n && (r = read(tube[0], erreur + len, n - 1 - len)) > 0) {
+		len += r;
+	}
+	erreur[len] = '\0';
+	close(tube[0]);
+	
+	int status;
+	waitpid(pid, &status, 0);
+	
+	return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
 int main(int argc, char *argv[]) {
 	// `sample1.afn`: accepte toutes les chaînes d'au moins un caractère contenant uniquement des `a` ou uniquement des `b`.
 	print(AFN A = afn_finit("sample1.afn"));
@@ -100,6 +240,457 @@ int main(int argc, char *argv[]) {
 	assert_rejected(H, "bbbbbb");
 	assert_accepted(H, "ba");
 	assert_accepted(H, "aab");
+	printf("\n");
+	
+	// test de la déterminisation
+	print(AFD I = afn_determiniser(A));
+	print(AFD J = afn_determiniser(H));
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afd_simuler
+	assert_rejected(I, "");
+	assert_accepted(I, "aa");
+	assert_accepted(I, "bb");
+	assert_rejected(I, "ab");
+	assert_rejected(I, "cca");
+	assert_accepted(J, "acbbbbb");
+	assert_rejected(J, "bbbbbb");
+	assert_accepted(J, "ba");
+	assert_accepted(J, "aab");
+	printf("\n");
+	
+	// test de l'AFD paresseux, avec un cache confortable puis minuscule (vidages et replis sur l'AFN)
+	print(AFDP K = afdp_init(H, 1 << 16));
+	print(AFDP L = afdp_init(H, 1));
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afdp_simuler
+	assert_accepted(K, "acbbbbb");
+	assert_accepted(K, "acbbbbb");
+	assert_rejected(K, "bbbbbb");
+	assert_accepted(K, "ba");
+	assert_rejected(K, "bad");
+	assert_accepted(L, "acbbbbb");
+	assert_rejected(L, "bbbbbb");
+	assert_accepted(L, "aab");
+	print(afdp_print_stats(K));
+	print(afdp_print_stats(L));
+	printf("\n");
+	
+	// test de la minimisation
+	print(AFD M = afd_minimiser(J));
+	print(AFD N = afd_minimiser(D));
+	print(afd_print(N));
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afd_simuler
+	assert_accepted(M, "acbbbbb");
+	assert_rejected(M, "bbbbbb");
+	assert_accepted(M, "ba");
+	assert_rejected(M, "bad");
+	assert_rejected(N, "");
+	assert_accepted(N, "D");
+	assert_rejected(N, "F");
+	assert_rejected(N, "ED");
+	printf("\n");
+	
+	// test de la table de transition compilée
+	print(AFDC O = afdc_compiler(C));
+	print(AFDC P = afdc_compiler(M));
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afdc_simuler
+	assert_rejected(O, "");
+	assert_accepted(O, "1101010");
+	assert_rejected(O, "101");
+	assert_rejected(O, "10 ");
+	assert_accepted(P, "acbbbbb");
+	assert_rejected(P, "bbbbbb");
+	assert_rejected(P, "ba\xff");
+	
+	// les mots testés sont complétés par des `b` jusqu'à 1 Mio, puis découpés en 4 morceaux
+	char *texte = malloc(TAILLE_TEXTE_LONG);
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC(T, s) afdc_simuler_parallele(T, texte, texte_long(texte, s), 4)
+	assert_accepted(P, "ac");
+	assert_rejected(P, "bb");
+	assert_rejected(P, "aca");
+	free(texte);
+	
+	// chaque mot testé est simulé au milieu du deuxième groupe d'un lot de 17 chaînes de longueurs différentes :
+	// il est donc lu par la boucle entrelacée, et non par celle qui termine le lot
+	const char *lot[17] = {
+		"acbbbbb", "", "ba", "bbbbbb", "abbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb", "a", "acb", "bab",
+		"aab", "b", NULL, "acbbbbbbbbbbbb", "bb", "aabc", "ac", "abababab",
+		"acbb"
+	};
+	size_t longueursLot[17];
+	unsigned char resultatsLot[17];
+	
+	// avec des longueurs explicites, une chaîne sur trois est privée de son dernier octet
+	for(int i = 0; i < 17; ++i) {
+		longueursLot[i] = (lot[i] != NULL) ? strlen(lot[i]) : 0;
+		if(i % 3 == 0 && longueursLot[i] > 0) {
+			--longueursLot[i];
+		}
+	}
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC(T, s) (lot[10] = s, afdc_simuler_lot(T, lot, NULL, 17, resultatsLot), resultatsLot[10])
+	assert_accepted(P, "aab");
+	assert_rejected(P, "aabc");
+	assert_rejected(P, "");
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC(T, s) (lot[10] = s, longueursLot[10] = strlen(s), afdc_simuler_lot(T, lot, longueursLot, 17, resultatsLot), resultatsLot[10])
+	assert_accepted(P, "aab");
+	assert_rejected(P, "aabc");
+	assert_rejected(P, "");
+	
+	// toutes les chaînes du lot, des deux groupes entrelacés comme de la fin, donnent le résultat de `afdc_simuler_n()`
+	int lotCorrect = 1;
+	lot[10] = "acbbb";
+	longueursLot[10] = 5;
+	
+	afdc_simuler_lot(P, lot, NULL, 17, resultatsLot);
+	for(int i = 0; i < 17; ++i) {
+		lotCorrect &= resultatsLot[i] == afdc_simuler_n(P, lot[i], strlen(lot[i]));
+	}
+	
+	afdc_simuler_lot(P, lot, longueursLot, 17, resultatsLot);
+	for(int i = 0; i < 17; ++i) {
+		lotCorrect &= resultatsLot[i] == afdc_simuler_n(P, lot[i], longueursLot[i]);
+	}
+	
+	if(!lotCorrect) {
+		fprintf(stderr, "assert failed: afdc_simuler_lot() and afdc_simuler_n() disagree on P\n");
+	}
+	else {
+		printf("assert ok: afdc_simuler_lot() and afdc_simuler_n() agree on P\n");
+	}
+	printf("\n");
+	
+	// test de la forme figée (CSR)
+	print(afn_figer(B));
+	print(afn_figer(H));
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afn_simuler
+	assert_accepted(B, "");
+	assert_accepted(B, "abbabbaaaabab");
+	assert_rejected(B, "c");
+	assert_accepted(H, "acbbbbb");
+	assert_rejected(H, "bbbbbb");
+	assert_accepted(H, "ba");
+	printf("\n");
+	
+	// test du format binaire, rechargé par projection en mémoire
+	print(binaire_ecrire_afdc(P, "out/P.bin"));
+	print(binaire_ecrire_afn(H, "out/H.bin"));
+	print(AFDC P2 = binaire_charger_afdc("out/P.bin", 1));
+	print(AFN H2 = binaire_charger_afn("out/H.bin", 1));
+	print(AFD H3 = afn_determiniser(H2));
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afdc_simuler
+	assert_accepted(P2, "acbbbbb");
+	assert_rejected(P2, "bbbbbb");
+	assert_rejected(P2, "ba\xff");
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afn_simuler
+	assert_accepted(H2, "acbbbbb");
+	assert_rejected(H2, "bbbbbb");
+	assert_accepted(H2, "ba");
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afd_simuler
+	assert_accepted(H3, "acbbbbb");
+	assert_rejected(H3, "bbbbbb");
+	assert_accepted(H3, "ba");
+	
+	// un fichier dont la somme de contrôle est juste mais dont une transition sort de la table est refusé
+	int transition = P->delta[P->q0];
+	P->delta[P->q0] = P->nbEtats * P->nbColonnes;
+	binaire_ecrire_afdc(P, "out/P_invalide.bin");
+	P->delta[P->q0] = transition;
+	
+	int arrivee = H->csr->dest[0];
+	H->csr->dest[0] = H->Q + 1;
+	binaire_ecrire_afn(H, "out/H_invalide.bin");
+	H->csr->dest[0] = arrivee;
+	
+	assert_erreur(binaire_charger_afdc("out/P_invalide.bin", 1), 1, "transition hors de la table");
+	assert_erreur(binaire_charger_afn("out/H_invalide.bin", 1), 1, "état d'arrivée hors de l'automate");
+	printf("\n");
+	
+	// test du chargeur en bloc, sur les mêmes fichiers que `afn_finit()` et `afd_finit()`
+	print(AFN A2 = chargeur_afn("sample1.afn", 1));
+	print(AFN B2 = chargeur_afn("sample2.afn", 4));
+	print(AFD C2 = chargeur_afd("sample3.afd", 1));
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afn_simuler
+	assert_accepted(A2, "aa");
+	assert_rejected(A2, "ab");
+	assert_accepted(B2, "abbabbaaaabab");
+	assert_rejected(B2, "c");
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afd_simuler
+	assert_accepted(C2, "1101010");
+	assert_rejected(C2, "101");
+	
+	// les fichiers malformés sont signalés comme par `afn_finit()` et `afd_finit()`, sauf un état supérieur à Q
+	// dans une transition, que seul le chargeur en bloc situe dans le fichier
+	assert_erreur(afn_finit("invalide1.afn"), 1, "invalide1.afn:8:5: nombre entier malformé: caractère inattendu 'x'\n");
+	assert_erreur(chargeur_afn("invalide1.afn", 1), 1, "invalide1.afn:8:5: nombre entier malformé: caractère inattendu 'x'\n");
+	assert_erreur(afd_finit("invalide1.afd"), 1, "invalide1.afd:8:4: nombre entier malformé\n");
+	assert_erreur(chargeur_afd("invalide1.afd", 4), 1, "invalide1.afd:8:4: nombre entier malformé\n");
+	assert_erreur(afn_finit("invalide2.afn"), 1, "check_param(): 'q2' n'a pas de valeur valide");
+	assert_erreur(chargeur_afn("invalide2.afn", 4), 1, "invalide2.afn:8:4: q > Q\n");
+	printf("\n");
+	
+	// test de la simulation par ensembles de bits
+	print(AFNB R = afnb_compiler(B));
+	print(AFNB S = afnb_compiler(H));
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afnb_simuler
+	assert_accepted(R, "");
+	assert_accepted(R, "abbabbaaaabab");
+	assert_rejected(R, "c");
+	assert_accepted(S, "acbbbbb");
+	assert_rejected(S, "bbbbbb");
+	assert_accepted(S, "ba");
+	assert_rejected(S, "bad");
+	printf("\n");
+	
+	// test de la suppression des epsilon-transitions
+	print(AFN T = afn_supprimer_epsilon(B));
+	print(AFN U = afn_supprimer_epsilon(H));
+	print(afn_dot(U, "U"));
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afn_simuler
+	assert_accepted(T, "");
+	assert_accepted(T, "abbabbaaaabab");
+	assert_rejected(T, "c");
+	assert_accepted(U, "acbbbbb");
+	assert_accepted(U, "ba");
+	assert_rejected(U, "bbbbbb");
+	assert_rejected(U, "a");
+	printf("\n");
+	
+	// test de la construction par opérateurs successifs, qui doit reconnaître le même langage que `compile()`
+	print(AFN V = compile_operateurs("(a+b)(a+c).b*"));
+	print(AFN W = compile("a*(b+c)*.a"));
+	
+	assert_accepted(V, "acbbbbb");
+	assert_accepted(V, "ba");
+	assert_rejected(V, "bbbbbb");
+	assert_accepted(W, "a");
+	assert_accepted(W, "aaabcbca");
+	assert_rejected(W, "aab");
+	assert_rejected(W, "");
+	printf("\n");
+	
+	// test de l'ajout de transitions par lot, fusionnées avec une transition existante : accepte `a(b+c)`
+	int q0 = 0, q2 = 2;
+	print(AFN X = afn_init(2, 1, &q0, 1, &q2, "abc"));
+	print(afn_ajouter_transition(X, 0, 'a', 1));
+	print(tbuf tampon = tbuf_new_empty());
+	print(tbuf_push(&tampon, 1, 'b', 2));
+	print(tbuf_push(&tampon, 0, 'a', 1));
+	print(tbuf_push(&tampon, 1, 'c', 2));
+	print(tbuf_push(&tampon, 1, 'b', 2));
+	print(afn_ajouter_transitions(X, &tampon));
+	
+	assert_accepted(X, "ab");
+	assert_accepted(X, "ac");
+	assert_rejected(X, "a");
+	assert_rejected(X, "abb");
+	printf("\n");
+	
+	// test de la recherche d'une occurrence n'importe où dans une chaîne
+	print(Recherche Y = recherche_compiler(H));
+	print(AFN Z = compile("ab*"));
+	print(Recherche Z2 = recherche_compiler(Z));
+	
+	assert_recherche(Y, "xxacbbb", 2, 4);
+	assert_recherche(Y, "bbbb", -1, -1);
+	assert_recherche(Y, "b-ba", 2, 4);
+	assert_recherche(Z2, "cabbb", 1, 2);
+	assert_recherche(Z2, "ccc", -1, -1);
+	printf("\n");
+	
+	// test de la reconnaissance de plusieurs motifs en une seule lecture
+	const char *motifs[] = { "ab*", "(a+b)*b", "c" };
+	int resultats[3];
+	print(Multi M1 = multi_compiler(motifs, 3, 0));
+	print(Multi M2 = multi_compiler(motifs, 3, 1));
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC(M, s) multi_executer(M, s, strlen(s), MULTI_TOUS, resultats)
+	assert_simul(M1, "abb", 2, "accepted twice");
+	assert_simul(M1, "bab", 1, "accepted once");
+	assert_simul(M1, "cc", 0, "rejected");
+	assert_simul(M2, "xcab", 3, "accepted three times");
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC(M, s) (multi_executer(M, s, strlen(s), MULTI_PREMIER, resultats) == 1 ? resultats[0] : -1)
+	assert_simul(M1, "abb", 0, "first accepted by pattern 0");
+	assert_simul(M2, "xcab", 2, "first accepted by pattern 2");
+	assert_simul(M2, "bbab", 1, "first accepted by pattern 1");
+	printf("\n");
+	
+	// test de l'extraction des littéraux obligatoires, et du préfiltre de la recherche
+	assert_litteral("err.(a+b)*", "err");
+	assert_litteral("(x+y)abc", "abc");
+	assert_litteral("(abc+xbcy)", "bc");
+	assert_litteral("a*b*", NULL);
+	
+	print(recherche_prefiltrer(Z2, "a"));
+	assert_recherche(Z2, "cabbb", 1, 2);
+	assert_recherche(Z2, "cbbb", -1, -1);
+	
+	// test de l'automate des positions, simulé sur un mot de 64 bits puis sur plusieurs (plus de 63 positions)
+	print(Glushkov G1 = glushkov_compiler("(a+b)*a(a+b)"));
+	print(Glushkov G2 = glushkov_compiler("(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*(ab+ba)*c"));
+	print(AFN G3 = glushkov_afn(G1));
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC glushkov_simuler
+	assert_accepted(G1, "aa");
+	assert_accepted(G1, "babbab");
+	assert_rejected(G1, "abb");
+	assert_rejected(G1, "");
+	assert_rejected(G1, "ac");
+	assert_accepted(G2, "abbac");
+	assert_accepted(G2, "c");
+	assert_rejected(G2, "abbc");
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afn_simuler
+	assert_accepted(G3, "bbaa");
+	assert_rejected(G3, "abba");
+	printf("\n");
+	
+	// test des simplifications de l'arbre syntaxique
+	assert_ast("a**", "a*");
+	assert_ast("(a+a)", "a");
+	assert_ast("a(bc)+(d+e)", "abc+d+e");
+	assert_ast("ab+ac+b", "a(b+c)+b");
+	assert_ast("abc+abd+a", "ab(c+d)+a");
+	assert_ast("(a+b)*c+(b+a)*c", "(a+b)*c+(b+a)*c");
+	printf("\n");
+	
+	// test de l'AFD construit par dérivées de Brzozowski, sans AFN
+	print(AFD G4 = derivee_compiler("(a+b)*a(a+b)"));
+	print(AFD G5 = derivee_compiler("(ab+ab)**.c*"));
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afd_simuler
+	assert_accepted(G4, "aa");
+	assert_accepted(G4, "babbab");
+	assert_rejected(G4, "abb");
+	assert_rejected(G4, "ac");
+	assert_accepted(G5, "");
+	assert_accepted(G5, "ababcc");
+	assert_rejected(G5, "abca");
+	
+	// une longue concaténation : la construction reste linéaire en la longueur du motif
+	char *long_motif = checked_malloc(20001);
+	for(int i = 0; i < 20000; ++i) {
+		long_motif[i] = "ab"[i % 2];
+	}
+	long_motif[20000] = '\0';
+	
+	AFD G6 = derivee_compiler(long_motif);
+	int accepte = afd_simuler(G6, long_motif);
+	long_motif[19999] = '\0';
+	
+	if(G6->Q != 20000 || !accepte || afd_simuler(G6, long_motif)) {
+		fprintf(stderr, "assert failed: G6 does not recognize exactly (ab)^10000\n");
+	}
+	else {
+		printf("assert ok: G6 recognizes exactly (ab)^10000\n");
+	}
+	printf("\n");
+	
+	// test des classes de symboles : sur l'alphabet des expressions régulières, seuls `a`, `b` et les autres symboles
+	// se distinguent, et la colonne des autres symboles sert aussi de colonne morte à la table
+	print(AFN K1 = compile("(a+b)*a(a+b)"));
+	print(AFD K2 = afn_determiniser(K1));
+	print(AFDC K3 = afdc_compiler(K2));
+	
+	if(K2->nbClasses != 3 || K3->nbColonnes != 3 || G4->nbClasses != 3) {
+		fprintf(stderr, "assert failed: K2, K3 and G4 do not have 3 columns\n");
+	}
+	else {
+		printf("assert ok: K2, K3 and G4 have 3 columns\n");
+	}
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afd_simuler
+	assert_accepted(K2, "aa");
+	assert_accepted(K2, "bbab");
+	assert_rejected(K2, "abb");
+	assert_rejected(K2, "ac");
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afdc_simuler
+	assert_accepted(K3, "bab");
+	assert_rejected(K3, "bac");
+	assert_rejected(K3, "ca");
+	
+	// test du cache de motifs compilés : un motif qui ne diffère d'un autre que par ses blancs partage son AFN,
+	// et avec une capacité d'une entrée, chaque nouveau motif évince le précédent
+	Cache C1 = cache_init(1, 0);
+	AFN L1 = cache_compiler(C1, "(a+b)*c");
+	AFN L2 = cache_compiler(C1, " ( a + b ) * c ");
+	AFN L3 = cache_compiler(C1, "ab");
+	AFN L4 = cache_compiler(C1, "(a+b)*c");
+	CacheStats S1 = cache_stats(C1);
+	
+	if(L1 != L2 || L1 == L4 || S1.succes != 1 || S1.echecs != 3 || S1.evictions != 2 || S1.entrees != 1) {
+		fprintf(stderr, "assert failed: C1 does not share or evict its entries\n");
+	}
+	else {
+		printf("assert ok: C1 shares and evicts its entries\n");
+	}
+
+#undef SIMUL_FUNC
+#define SIMUL_FUNC afn_simuler
+	// `L1` a été évincé mais reste valide tant qu'il est référencé
+	assert_accepted(L1, "abbac");
+	assert_rejected(L1, "abba");
+	assert_accepted(L3, "ab");
+	assert_accepted(L4, "c");
+	
+	cache_rendre(C1, L1);
+	cache_rendre(C1, L2);
+	cache_rendre(C1, L3);
+	cache_rendre(C1, L4);
+	printf("\n");
+	
+	// test des compteurs d'instrumentation (seulement avec `make STATS=1`)
+	if(stats_actives()) {
+		stats_reinitialiser();
+		afn_simuler(B, "abba");
+		Stats S = stats_lire();
+		if(S.octets != 4 || S.fermetures == 0 || S.actifsMax == 0) {
+			fprintf(stderr, "assert failed: stats of \"abba\" by B\n");
+		}
+		else {
+			printf("assert ok: stats of \"abba\" by B\n");
+		}
+	}
+	else {
+		printf("stats disabled\n");
+	}
+	printf("\n");
 	
 	afn_free(A);
 	afn_free(B);
@@ -109,4 +700,42 @@ int main(int argc, char *argv[]) {
 	afn_free(F);
 	afn_free(G);
 	afn_free(H);
+	afd_free(I);
+	afd_free(J);
+	afdp_free(K);
+	afdp_free(L);
+	afd_free(M);
+	afd_free(N);
+	afdc_free(O);
+	afdc_free(P);
+	afdc_free(P2);
+	afn_free(H2);
+	afd_free(H3);
+	afn_free(A2);
+	afn_free(B2);
+	afd_free(C2);
+	afnb_free(R);
+	afnb_free(S);
+	afn_free(T);
+	afn_free(U);
+	afn_free(V);
+	afn_free(W);
+	afn_free(X);
+	tbuf_free(&tampon);
+	recherche_free(Y);
+	afn_free(Z);
+	recherche_free(Z2);
+	multi_free(M1);
+	multi_free(M2);
+	glushkov_free(G1);
+	glushkov_free(G2);
+	afn_free(G3);
+	afd_free(G4);
+	afd_free(G5);
+	afd_free(G6);
+	free(long_motif);
+	afn_free(K1);
+	afd_free(K2);
+	afdc_free(K3);
+	cache_free(C1);
 }
@@ -0,0 +1,138 @@
+#include "util/arena.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "util/misc.h"
+
+/**
+ * L'alignement de chaque allocation, suffisant pour tout type de base.
+ */
+#define ARENA_ALIGNEMENT 16
+
+/**
+ * La capacité du premier bloc ordinaire d'une arène, puis la capacité au-delà de laquelle elle ne double plus.
+ */
+#define ARENA_BLOC_MIN (1 << 12)
+#define ARENA_BLOC_MAX (1 << 22)
+
+/**
+ * La taille de l'en-tête d'un bloc, arrondie à l'alignement : les données commencent juste après.
+ */
+#define ARENA_ENTETE ((sizeof(struct arena_bloc) + ARENA_ALIGNEMENT - 1) & ~((size_t) ARENA_ALIGNEMENT - 1))
+
+
+/**
+ * Créer une nouvelle arène vide ; aucun bloc n'est alloué avant la première allocation.
+ */
+arena arena_new_empty() {
+	arena a;
+	a.courant = NULL;
+	a.prochain = ARENA_BLOC_MIN;
+	
+	return a;
+}
+
+
+/**
+ * Alloue et renvoie un nouveau bloc de `capacity` octets de données, vide.
+ */
+static struct arena_bloc* arena_bloc_new(size_t capacity) {
+	check_param("capacity", capacity <= SIZE_MAX - ARENA_ENTETE);
+	
+	struct arena_bloc *b = checked_malloc(ARENA_ENTETE + capacity);
+	b->precedent = NULL;
+	b->capacity = capacity;
+	b->len = 0;
+	
+	return b;
+}
+
+
+/**
+ * Renvoie un pointeur vers `n` octets pris dans l'arène, alignés pour tout type de base.
+ *
+ * La mémoire n'est pas initialisée, et reste valide jusqu'à l'appel de `arena_free()`.
+ */
+void* arena_alloc(arena *a, size_t n) {
+	check_param("n", n <= SIZE_MAX - ARENA_ALIGNEMENT);
+	n = (n + ARENA_ALIGNEMENT - 1) & ~((size_t) ARENA_ALIGNEMENT - 1);
+	
+	struct arena_bloc *b = a->courant;
+	
+	if(b == NULL || b->capacity - b->len < n) {
+		if(n > a->prochain / 2) {
+			// bloc dédié, chaîné derrière le bloc courant afin que celui-ci continue de servir les petites allocations
+			struct arena_bloc *d = arena_bloc_new(n);
+			
+			if(b == NULL) {
+				a->courant = d;
+			}
+			else {
+				d->precedent = b->precedent;
+				b->precedent = d;
+			}
+			
+			d->len = n;
+			return (char*) d + ARENA_ENTETE;
+		}
+		
+		b = arena_bloc_new(a->prochain);
+		b->precedent = a->courant;
+		a->courant = b;
+		
+		if(a->prochain < ARENA_BLOC_MAX) {
+			a->prochain *= 2;
+		}
+	}
+	
+	void *p = (char*) b + ARENA_ENTETE + b->len;
+	b->len += n;
+	
+	return p;
+}
+
+
+/**
+ * Renvoie un pointeur vers `n` octets nuls pris dans l'arène.
+ *
+ * Voir aussi:
+ * - `arena_alloc(arena*, size_t)`
+ */
+void* arena_calloc(arena *a, size_t n) {
+	void *p = arena_alloc(a, n);
+	memset(p, 0, n);
+	
+	return p;
+}
+
+
+/**
+ * Renvoie le nombre d'octets réservés par l'arène, en-têtes des blocs compris.
+ */
+size_t arena_taille(const arena *a) {
+	size_t taille = 0;
+	
+	for(const struct arena_bloc *b = a->courant; b != NULL; b = b->precedent) {
+		taille += ARENA_ENTETE + b->capacity;
+	}
+	
+	return taille;
+}
+
+
+/**
+ * Libère tous les blocs de l'arène, et donc toutes les allocations qui en proviennent ; l'arène redevient vide.
+ */
+void arena_free(arena *a) {
+	struct arena_bloc *b = a->courant;
+	
+	while(b != NULL) {
+		struct arena_bloc *precedent = b->precedent;
+		free(b);
+		b = precedent;
+	}
+	
+	*a = arena_new_empty();
+}
@@ -0,0 +1,84 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/*
+ * arena pour allocateur par région, utilisé pour allouer d'un seul tenant les nombreux petits tableaux d'un automate
+ */
+
+/**
+ * Représente un bloc de mémoire d'une arène, suivi de ses `capacity` octets de données.
+ */
+struct arena_bloc {
+	/**
+	 * Le bloc alloué avant celui-ci, ou `NULL`.
+	 */
+	struct arena_bloc *precedent;
+	
+	/**
+	 * Le nombre d'octets de données du bloc.
+	 */
+	size_t capacity;
+	
+	/**
+	 * Le nombre d'octets de données déjà distribués ({@code len <= capacity}).
+	 */
+	size_t len;
+};
+
+
+/**
+ * Représente une arène : les allocations sont prises à la suite les unes des autres dans des blocs dont la taille
+ * double à chaque agrandissement, et ne sont jamais libérées une à une, mais toutes ensemble par `arena_free()`.
+ *
+ * Une allocation plus grande qu'un bloc ordinaire reçoit son propre bloc, de la taille exacte demandée.
+ */
+typedef struct {
+	/**
+	 * Le bloc dans lequel sont prises les prochaines allocations, ou `NULL` si l'arène est vide.
+	 */
+	struct arena_bloc *courant;
+	
+	/**
+	 * La capacité du prochain bloc ordinaire.
+	 */
+	size_t prochain;
+} arena;
+
+
+/**
+ * Créer une nouvelle arène vide ; aucun bloc n'est alloué avant la première allocation.
+ */
+arena arena_new_empty();
+
+
+/**
+ * Renvoie un pointeur vers `n` octets pris dans l'arène, alignés pour tout type de base.
+ *
+ * La mémoire n'est pas initialisée, et reste valide jusqu'à l'appel de `arena_free()`.
+ */
+void* arena_alloc(arena *a, size_t n);
+
+
+/**
+ * Renvoie un pointeur vers `n` octets nuls pris dans l'arène.
+ *
+ * Voir aussi:
+ * - `arena_alloc(arena*, size_t)`
+ */
+void* arena_calloc(arena *a, size_t n);
+
+
+/**
+ * Renvoie le nombre d'octets réservés par l'arène, en-têtes des blocs compris.
+ */
+size_t arena_taille(const arena *a);
+
+
+/**
+ * Libère tous les blocs de l'arène, et donc toutes les allocations qui en proviennent ; l'arène redevient vide.
+ */
+void arena_free(arena *a);
+
+#endif // ARENA_H
@@ -1,4 +1,5 @@
 #include "util/misc.h"
+#include "util/stats.h"
 
 #include <ctype.h>
 #include <stdio.h>
@@ -36,6 +37,9 @@ static void bad_param(const char *pname) {
 void* checked_malloc(size_t size) {
 	check_param("size", size != 0);
 	
+	STATS_AJOUTER(mallocs, 1);
+	STATS_AJOUTER(mallocOctets, size);
+	
 	void* ptr = malloc(size);
 	if(!ptr) {
 		bad_alloc();
@@ -271,6 +275,7 @@ int* fparse_int_set(FILE *f, const char *fpath, size_t *fline, char **buf, size_
 char* fparse_Sigma(FILE *f, const char *fpath, size_t *fline, char **buf, size_t *bufCapacity, int *outLen) {
 	int len;
 	
+	++(*fline);
 	if((len = getline(buf, bufCapacity, f)) > 0) {
 		char *line = *buf;
 		int last = len - 1;
@@ -311,6 +316,8 @@ int fparse_transition(FILE *f, const char *fpath, size_t *fline, char **buf, siz
 	ssize_t read;
 	
 	if((read = getline(buf, bufCapacity, f)) > 0) {
+		++(*fline);
+		
 		size_t bufLen = read;
 		char *bufPtr = *buf;
 		
@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "util/misc.h"
+#include "util/stats.h"
 
 /**
  * Créer un nouvel ensemble vide.
@@ -56,6 +57,8 @@ set set_copy_from(const int *values, size_t n) {
  * Rajoute un nouvel élément à l'ensemble, renvoyant `0` si l'élément est déjà présent.
  */
 int set_push(set *s, int val) {
+	STATS_AJOUTER(setPush, 1);
+	
 	// binary search
 	size_t i = 0;
 	size_t j = s->len;
@@ -105,6 +108,8 @@ int set_push(set *s, int val) {
  * Calcul l'union de deux ensembles.
  */
 set set_union(set rhs, set lhs) {
+	STATS_AJOUTER(setUnion, 1);
+	
 	size_t len = rhs.len + lhs.len;
 	if(len == 0) {
 		return set_new_empty();
@@ -0,0 +1,191 @@
+#include "util/setmap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "util/misc.h"
+
+/**
+ * Calcul l'empreinte d'un ensemble (FNV-1a sur ses éléments).
+ */
+static size_t setmap_hash(set s) {
+	size_t h = (size_t) 14695981039346656037ULL;
+	
+	for(size_t i = 0; i < s.len; ++i) {
+		h ^= (size_t) (unsigned int) s.buf[i];
+		h *= (size_t) 1099511628211ULL;
+	}
+	
+	return h;
+}
+
+
+/**
+ * Renvoie `1` si les deux ensembles contiennent exactement les mêmes éléments, sinon renvoie `0`.
+ */
+static int setmap_equals(set lhs, set rhs) {
+	return lhs.len == rhs.len && (lhs.len == 0 || memcmp(lhs.buf, rhs.buf, lhs.len * sizeof(int)) == 0);
+}
+
+
+/**
+ * Renvoie l'indice de la case de `table` contenant l'ensemble `s` d'empreinte `h`,
+ * ou l'indice de la case libre où il devrait être inséré.
+ */
+static size_t setmap_probe(const setmap *m, set s, size_t h) {
+	size_t mask = m->tableCapacity - 1;
+	size_t i = h & mask;
+	
+	while(m->table[i] != -1) {
+		int id = m->table[i];
+		
+		if(m->empreintes[id] == h && setmap_equals(m->cles[id], s)) {
+			break;
+		}
+		
+		i = (i + 1) & mask;
+	}
+	
+	return i;
+}
+
+
+/**
+ * Double la taille de `table` et y replace tous les identifiants.
+ */
+static void setmap_grow(setmap *m) {
+	free(m->table);
+	
+	m->tableCapacity = (m->tableCapacity == 0) ? 16 : (m->tableCapacity * 2);
+	m->table = checked_malloc(m->tableCapacity * sizeof(int));
+	memset(m->table, -1, m->tableCapacity * sizeof(int));
+	
+	size_t mask = m->tableCapacity - 1;
+	for(size_t id = 0; id < m->len; ++id) {
+		size_t i = m->empreintes[id] & mask;
+		
+		while(m->table[i] != -1) {
+			i = (i + 1) & mask;
+		}
+		
+		m->table[i] = (int) id;
+	}
+}
+
+
+/**
+ * Créer une nouvelle table vide.
+ */
+setmap setmap_new_empty() {
+	setmap m;
+	m.cles = NULL;
+	m.empreintes = NULL;
+	m.len = 0;
+	m.capacity = 0;
+	m.table = NULL;
+	m.tableCapacity = 0;
+	
+	return m;
+}
+
+
+/**
+ * Renvoie l'identifiant de l'ensemble spécifié, ou `-1` s'il n'a pas encore été interné.
+ */
+int setmap_get(const setmap *m, set s) {
+	if(m->tableCapacity == 0) {
+		return -1;
+	}
+	
+	return m->table[setmap_probe(m, s, setmap_hash(s))];
+}
+
+
+/**
+ * Renvoie l'identifiant de l'ensemble `*s`, en l'internant s'il n'est pas encore présent.
+ *
+ * Si l'ensemble est nouveau, la table en prend possession et `*s` est remplacé par un ensemble vide ;
+ * `*nouveau` (si non `NULL`) indique si l'ensemble vient d'être ajouté.
+ */
+int setmap_intern(setmap *m, set *s, int *nouveau) {
+	// on garde un facteur de remplissage inférieur à 1/2
+	if(2 * (m->len + 1) > m->tableCapacity) {
+		setmap_grow(m);
+	}
+	
+	size_t h = setmap_hash(*s);
+	size_t i = setmap_probe(m, *s, h);
+	
+	if(m->table[i] != -1) {
+		if(nouveau != NULL) {
+			*nouveau = 0;
+		}
+		
+		return m->table[i];
+	}
+	
+	if(m->len == m->capacity) {
+		m->capacity = (m->capacity == 0) ? 16 : (m->capacity * 2);
+		m->cles = checked_realloc(m->cles, m->capacity * sizeof(set));
+		m->empreintes = checked_realloc(m->empreintes, m->capacity * sizeof(size_t));
+	}
+	
+	int id = (int) m->len;
+	m->cles[id] = *s;
+	m->empreintes[id] = h;
+	m->table[i] = id;
+	++(m->len);
+	
+	*s = set_new_empty();
+	
+	if(nouveau != NULL) {
+		*nouveau = 1;
+	}
+	
+	return id;
+}
+
+
+/**
+ * Libère tous les ensembles internés sans libérer les tableaux de la table.
+ */
+void setmap_clear(setmap *m) {
+	for(size_t id = 0; id < m->len; ++id) {
+		set_free(&m->cles[id]);
+	}
+	
+	m->len = 0;
+	
+	if(m->table != NULL) {
+		memset(m->table, -1, m->tableCapacity * sizeof(int));
+	}
+}
+
+
+/**
+ * Renvoie une estimation de l'espace mémoire (en octets) occupé par la table.
+ */
+size_t setmap_memory(const setmap *m) {
+	size_t bytes = m->capacity * (sizeof(set) + sizeof(size_t)) + m->tableCapacity * sizeof(int);
+	
+	for(size_t id = 0; id < m->len; ++id) {
+		bytes += m->cles[id].capacity * sizeof(int);
+	}
+	
+	return bytes;
+}
+
+
+/**
+ * Libère l'espace mémoire occupé par cette table et par tous les ensembles internés.
+ */
+void setmap_free(setmap *m) {
+	setmap_clear(m);
+	
+	free(m->cles);
+	free(m->empreintes);
+	free(m->table);
+	
+	*m = setmap_new_empty();
+}
@@ -0,0 +1,79 @@
+#ifndef SETMAP_H
+#define SETMAP_H
+
+#include <stddef.h>
+
+#include "util/set.h"
+
+/**
+ * Représente une table de hachage qui associe à chaque ensemble d'états un identifiant unique.
+ *
+ * Les identifiants sont attribués dans l'ordre d'insertion à partir de zéro, ce qui permet
+ * de retrouver un ensemble à partir de son identifiant avec `cles[id]`.
+ */
+typedef struct {
+	/**
+	 * Les ensembles internés, indexés par leur identifiant.
+	 */
+	set *cles;
+	
+	/**
+	 * Les empreintes des ensembles internés, indexées par leur identifiant.
+	 */
+	size_t *empreintes;
+	
+	/**
+	 * Le nombre d'ensembles internés.
+	 */
+	size_t len;
+	
+	/**
+	 * La taille des tableaux `cles` et `empreintes`.
+	 */
+	size_t capacity;
+	
+	/**
+	 * La table d'adressage ouvert : chaque case contient un identifiant, ou `-1` si elle est libre.
+	 */
+	int *table;
+	
+	/**
+	 * Le nombre de cases de `table` (toujours une puissance de deux).
+	 */
+	size_t tableCapacity;
+} setmap;
+
+/**
+ * Créer une nouvelle table vide.
+ */
+setmap setmap_new_empty();
+
+/**
+ * Renvoie l'identifiant de l'ensemble spécifié, ou `-1` s'il n'a pas encore été interné.
+ */
+int setmap_get(const setmap *m, set s);
+
+/**
+ * Renvoie l'identifiant de l'ensemble `*s`, en l'internant s'il n'est pas encore présent.
+ *
+ * Si l'ensemble est nouveau, la table en prend possession et `*s` est remplacé par un ensemble vide ;
+ * `*nouveau` (si non `NULL`) indique si l'ensemble vient d'être ajouté.
+ */
+int setmap_intern(setmap *m, set *s, int *nouveau);
+
+/**
+ * Libère tous les ensembles internés sans libérer les tableaux de la table.
+ */
+void setmap_clear(setmap *m);
+
+/**
+ * Renvoie une estimation de l'espace mémoire (en octets) occupé par la table.
+ */
+size_t setmap_memory(const setmap *m);
+
+/**
+ * Libère l'espace mémoire occupé par cette table et par tous les ensembles internés.
+ */
+void setmap_free(setmap *m);
+
+#endif // SETMAP_H
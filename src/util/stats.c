@@ -0,0 +1,83 @@
+#include "util/stats.h"
+
+#include <string.h>
+
+#ifdef AF_STATS
+Stats af_stats;
+#endif
+
+
+/**
+ * Renvoie `1` si la bibliothèque a été compilée avec les compteurs, sinon `0`.
+ */
+int stats_actives() {
+#ifdef AF_STATS
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+
+/**
+ * Renvoie une copie des compteurs actuels ; tous nuls si les compteurs sont désactivés.
+ */
+Stats stats_lire() {
+	Stats S;
+	memset(&S, 0, sizeof(Stats));
+
+#ifdef AF_STATS
+	// chaque compteur est lu de façon atomique, mais pas l'ensemble des compteurs
+	unsigned long long *dst = (unsigned long long*) &S;
+	unsigned long long *src = (unsigned long long*) &af_stats;
+	
+	for(size_t i = 0; i < sizeof(Stats) / sizeof(unsigned long long); ++i) {
+		dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+	}
+#endif
+	
+	return S;
+}
+
+
+/**
+ * Remet tous les compteurs à zéro.
+ */
+void stats_reinitialiser() {
+#ifdef AF_STATS
+	unsigned long long *c = (unsigned long long*) &af_stats;
+	
+	for(size_t i = 0; i < sizeof(Stats) / sizeof(unsigned long long); ++i) {
+		__atomic_store_n(&c[i], 0, __ATOMIC_RELAXED);
+	}
+#endif
+}
+
+
+/**
+ * Renvoie `total / n`, ou `0` si `n` est nul.
+ */
+static double moyenne(unsigned long long total, unsigned long long n) {
+	return (n > 0) ? (double) total / n : 0.0;
+}
+
+
+/**
+ * Affiche les compteurs actuels dans le flux spécifié, ou un avertissement si les compteurs sont désactivés.
+ */
+void stats_afficher(FILE *f) {
+	if(!stats_actives()) {
+		fprintf(f, "statistiques indisponibles : recompiler avec `make clean && make STATS=1`\n");
+		return;
+	}
+	
+	Stats S = stats_lire();
+	
+	fprintf(f, "états créés              : %llu\n", S.etats);
+	fprintf(f, "epsilon-fermetures       : %llu (taille moyenne %.1f, max %llu)\n",
+		S.fermetures, moyenne(S.fermeturesEtats, S.fermetures), S.fermetureMax);
+	fprintf(f, "octets lus (afn_simuler) : %llu (états actifs par octet : moyenne %.1f, max %llu)\n",
+		S.octets, moyenne(S.actifs, S.octets), S.actifsMax);
+	fprintf(f, "set_push / set_union     : %llu / %llu\n", S.setPush, S.setUnion);
+	fprintf(f, "checked_malloc           : %llu appels, %llu octets\n", S.mallocs, S.mallocOctets);
+}
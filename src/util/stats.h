@@ -0,0 +1,97 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+
+/**
+ * Représente les compteurs d'instrumentation des moteurs, cumulés depuis le début du programme
+ * ou le dernier appel à `stats_reinitialiser()`.
+ *
+ * Les compteurs ne sont mis à jour que si la bibliothèque est compilée avec `AF_STATS` défini
+ * (`make clean && make STATS=1`) ; sinon, les macros `STATS_*` ne génèrent aucun code.
+ */
+typedef struct {
+	/**
+	 * Le nombre d'états créés par `compile()`, `afn_char()`, `afn_union()`, `afn_union_multiple()`,
+	 * `afn_concat()` et `afn_kleene()`.
+	 */
+	unsigned long long etats;
+	
+	/**
+	 * Le nombre d'epsilon-fermetures calculées par `afn_epsilon_closure_assign()` (sur un AFN pouvant posséder
+	 * des epsilon-transitions), ainsi que la somme et le maximum de leurs tailles.
+	 */
+	unsigned long long fermetures;
+	unsigned long long fermeturesEtats;
+	unsigned long long fermetureMax;
+	
+	/**
+	 * Le nombre d'octets lus par `afn_simuler()`, ainsi que la somme et le maximum du nombre d'états actifs
+	 * après chacun d'eux.
+	 */
+	unsigned long long octets;
+	unsigned long long actifs;
+	unsigned long long actifsMax;
+	
+	/**
+	 * Le nombre d'appels à `set_push()` et à `set_union()`.
+	 */
+	unsigned long long setPush;
+	unsigned long long setUnion;
+	
+	/**
+	 * Le nombre d'appels à `checked_malloc()` et le nombre d'octets alloués par ceux-ci.
+	 */
+	unsigned long long mallocs;
+	unsigned long long mallocOctets;
+} Stats;
+
+
+#ifdef AF_STATS
+
+/**
+ * Les compteurs globaux, mis à jour de façon atomique : les moteurs peuvent être utilisés par plusieurs threads.
+ */
+extern Stats af_stats;
+
+#define STATS_AJOUTER(champ, n) __atomic_fetch_add(&af_stats.champ, (unsigned long long) (n), __ATOMIC_RELAXED)
+#define STATS_MAX(champ, n) stats_max(&af_stats.champ, (unsigned long long) (n))
+
+static inline void stats_max(unsigned long long *m, unsigned long long n) {
+	unsigned long long v = __atomic_load_n(m, __ATOMIC_RELAXED);
+	while(n > v && !__atomic_compare_exchange_n(m, &v, n, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+	}
+}
+
+#else
+
+#define STATS_AJOUTER(champ, n) ((void) 0)
+#define STATS_MAX(champ, n) ((void) 0)
+
+#endif // AF_STATS
+
+
+/**
+ * Renvoie `1` si la bibliothèque a été compilée avec les compteurs, sinon `0`.
+ */
+int stats_actives();
+
+
+/**
+ * Renvoie une copie des compteurs actuels ; tous nuls si les compteurs sont désactivés.
+ */
+Stats stats_lire();
+
+
+/**
+ * Remet tous les compteurs à zéro.
+ */
+void stats_reinitialiser();
+
+
+/**
+ * Affiche les compteurs actuels dans le flux spécifié, ou un avertissement si les compteurs sont désactivés.
+ */
+void stats_afficher(FILE *f);
+
+#endif // STATS_H
@@ -0,0 +1,70 @@
+#include "util/tbuf.h"
+
+#include <stdlib.h>
+
+#include "util/misc.h"
+
+/**
+ * Créer un nouveau tampon vide.
+ */
+tbuf tbuf_new_empty() {
+	tbuf t;
+	t.buf = NULL;
+	t.len = 0;
+	t.capacity = 0;
+	
+	return t;
+}
+
+
+/**
+ * Ajoute la transition `q1 --c--> q2` au tampon et renvoie son indice.
+ */
+size_t tbuf_push(tbuf *t, int q1, char c, int q2) {
+	if(t->len == t->capacity) {
+		tbuf_reserve(t, t->capacity > 0 ? t->capacity : 16);
+	}
+	
+	transition *tr = &t->buf[t->len];
+	tr->q1 = q1;
+	tr->q2 = q2;
+	tr->c = c;
+	
+	return t->len++;
+}
+
+
+/**
+ * Réserve de la place pour au moins `n` nouvelles transitions.
+ */
+void tbuf_reserve(tbuf *t, size_t n) {
+	if(t->len + n > t->capacity) {
+		t->capacity = t->len + n;
+		
+		if(t->buf == NULL) {
+			t->buf = checked_malloc(t->capacity * sizeof(transition));
+		}
+		else {
+			t->buf = checked_realloc(t->buf, t->capacity * sizeof(transition));
+		}
+	}
+}
+
+
+/**
+ * Vide le tampon sans libérer sa mémoire.
+ */
+void tbuf_clear(tbuf *t) {
+	t->len = 0;
+}
+
+
+/**
+ * Libère les ressources allouées à un tampon.
+ */
+void tbuf_free(tbuf *t) {
+	free(t->buf);
+	t->buf = NULL;
+	t->len = 0;
+	t->capacity = 0;
+}
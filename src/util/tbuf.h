@@ -0,0 +1,70 @@
+#ifndef TBUF_H
+#define TBUF_H
+
+#include <stddef.h>
+
+/*
+ * tbuf pour transition buffer, utilisé pour ajouter en une seule fois un grand nombre de transitions à un AFN
+ */
+
+/**
+ * Représente une transition `q1 --c--> q2`.
+ */
+typedef struct {
+	int q1;
+	int q2;
+	char c;
+} transition;
+
+
+/**
+ * Représente un tampon de transitions stockées dans un tableau, dont la capacité double à chaque agrandissement.
+ */
+typedef struct {
+	/**
+	 * Le tableau contenant toutes les transitions du tampon.
+	 */
+	transition *buf;
+	
+	/**
+	 * Le nombre de transitions du tampon.
+	 */
+	size_t len;
+	
+	/**
+	 * La taille du tableau ({@code len <= capacity})
+	 */
+	size_t capacity;
+} tbuf;
+
+
+/**
+ * Créer un nouveau tampon vide.
+ */
+tbuf tbuf_new_empty();
+
+
+/**
+ * Ajoute la transition `q1 --c--> q2` au tampon et renvoie son indice.
+ */
+size_t tbuf_push(tbuf *t, int q1, char c, int q2);
+
+
+/**
+ * Réserve de la place pour au moins `n` nouvelles transitions.
+ */
+void tbuf_reserve(tbuf *t, size_t n);
+
+
+/**
+ * Vide le tampon sans libérer sa mémoire.
+ */
+void tbuf_clear(tbuf *t);
+
+
+/**
+ * Libère les ressources allouées à un tampon.
+ */
+void tbuf_free(tbuf *t);
+
+#endif // TBUF_H